@@ -0,0 +1,58 @@
+#ifndef BENCH_UTILS_H
+#define BENCH_UTILS_H
+
+// Timing helpers shared by the bench/ programs of every lab.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace bench
+{
+    // Runs fn once and returns the elapsed wall time in seconds.
+    template <typename Fn>
+    double measure(Fn&& fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(stop - start).count();
+    }
+
+    // Keeps the optimizer from discarding a computed value: the compiler has to assume the barrier reads
+    // value through its address, so value must be computed and stored first.
+    template <typename T>
+    void doNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        static const volatile char* volatile sink;
+        sink = &reinterpret_cast<const volatile char&>(value);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "g"(&value) : "memory");
+#endif
+    }
+
+    // Reads a size from argv[index], falling back to def.
+    inline std::size_t argOr(int argc, char** argv, int index, std::size_t def)
+    {
+        if (index < argc) return static_cast<std::size_t>(std::strtoull(argv[index], nullptr, 10));
+        return def;
+    }
+
+    inline void report(const std::string& name, double seconds, std::size_t ops)
+    {
+        std::cout << std::left << std::setw(36) << name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1e3 << " ms"
+                  << std::setw(16) << std::setprecision(1) << ops / seconds << " ops/s" << std::endl;
+    }
+} // namespace bench
+
+#endif // BENCH_UTILS_H
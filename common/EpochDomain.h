@@ -0,0 +1,73 @@
+#ifndef EPOCH_DOMAIN_H
+#define EPOCH_DOMAIN_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// Shared by lab_6 (ConcurrentMap) and lab_7 (ConcurrentHashTable).
+namespace reclaim
+{
+    // Epoch-based reclamation. Readers announce the epoch they entered in; memory retired in epoch E
+    // is freed once every active reader has announced an epoch greater than E.
+    template <std::size_t Slots>
+    class EpochDomain {
+    public:
+        static constexpr std::uint64_t idle = 0;
+
+        class Guard {
+        public:
+            explicit Guard(EpochDomain& domain) : m_slot(domain.enter()) {}
+            ~Guard() { if (m_slot) m_slot->store(idle, std::memory_order_release); }
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+
+            // False when every slot was busy; the caller must then read under the writers' lock.
+            explicit operator bool() const noexcept { return m_slot != nullptr; }
+
+        private:
+            std::atomic<std::uint64_t>* m_slot;
+        };
+
+        // Called by a writer after unpublishing memory; returns the epoch it was retired in.
+        std::uint64_t advance() {
+            return m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        }
+
+        // Smallest epoch still announced by a reader, or UINT64_MAX if none is active.
+        std::uint64_t oldestActive() const {
+            std::uint64_t oldest = UINT64_MAX;
+            for (const auto& slot : m_slots) {
+                std::uint64_t e = slot.epoch.load(std::memory_order_seq_cst);
+                if (e != idle && e < oldest) oldest = e;
+            }
+            return oldest;
+        }
+
+    private:
+        struct alignas(64) Slot {
+            std::atomic<std::uint64_t> epoch{ idle };
+        };
+
+        std::array<Slot, Slots> m_slots;
+        std::atomic<std::uint64_t> m_epoch{ 1 };
+
+        std::atomic<std::uint64_t>* enter() {
+            std::size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % Slots;
+            for (std::size_t i = 0; i < Slots; ++i) {
+                auto& slot = m_slots[(start + i) % Slots].epoch;
+                std::uint64_t expected = idle;
+                std::uint64_t e = m_epoch.load(std::memory_order_seq_cst);
+                if (slot.load(std::memory_order_relaxed) == idle &&
+                    slot.compare_exchange_strong(expected, e, std::memory_order_seq_cst))
+                    return &slot;
+            }
+            return nullptr;
+        }
+    };
+} // namespace reclaim
+
+#endif // EPOCH_DOMAIN_H
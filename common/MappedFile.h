@@ -0,0 +1,100 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Shared by lab_6 (MapIO) and lab_7 (FlightLoader).
+namespace io
+{
+    // How the mapping will be read; passed on to the OS as a read-ahead hint.
+    enum class Access { Random, Sequential };
+
+    // Read-only memory mapping of a whole file. Throws std::runtime_error if the file cannot be opened,
+    // sized or mapped.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path, Access access = Access::Random) {
+#ifdef _WIN32
+            DWORD flags = FILE_ATTRIBUTE_NORMAL | (access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : 0);
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("MappedFile: cannot open " + path);
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(m_file, &size)) {
+                CloseHandle(m_file);
+                throw std::runtime_error("MappedFile: cannot stat " + path);
+            }
+            m_size = static_cast<std::size_t>(size.QuadPart);
+            if (m_size) {
+                m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (m_mapping) m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                if (!m_data) {
+                    if (m_mapping) CloseHandle(m_mapping);
+                    CloseHandle(m_file);
+                    throw std::runtime_error("MappedFile: cannot map " + path);
+                }
+            }
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("MappedFile: cannot open " + path);
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("MappedFile: cannot stat " + path);
+            }
+            m_size = static_cast<std::size_t>(st.st_size);
+            if (m_size) {
+                void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("MappedFile: cannot map " + path);
+                }
+                if (access == Access::Sequential) ::madvise(data, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(data);
+            }
+            ::close(fd);
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+#ifdef _WIN32
+            if (m_data) UnmapViewOfFile(m_data);
+            if (m_mapping) CloseHandle(m_mapping);
+            CloseHandle(m_file);
+#else
+            if (m_data) ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+        }
+
+        const char* data() const noexcept { return m_data; }
+        std::size_t size() const noexcept { return m_size; }
+
+    private:
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+#ifdef _WIN32
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+    };
+} // namespace io
+
+#endif // MAPPED_FILE_H
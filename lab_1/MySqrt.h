@@ -0,0 +1,148 @@
+#ifndef MY_SQRT_H
+#define MY_SQRT_H
+
+#include "SqrtKernels.h"
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Newton's method for sqrt(a), one recursive call per step.
+//
+// The original stopping rule, |x_n+1 - x_n| < epsilon, is absolute. For tiny a it is met while x is still
+// far from a root that is itself below epsilon: mySqrt(1e-300) stops after 23 steps at 6e-8. For large a
+// it holds only once two iterates come out exactly equal. SqrtOptions adds two rules that scale with the
+// root: a relative step size, and a distance in ulps between successive iterates. Because the method
+// converges quadratically, a relative step of 1e-8 already means the next iterate is good to about 1e-16.
+//
+// Whatever the rule, the number of steps is dominated by the start. From 0.5 * (1 + a) each step only
+// halves x until it nears the root, about 1.7 steps per decade of sqrt(a) -- 500 for a = 1e300. The
+// exponent start takes the guess from the bit pattern of a instead (see SqrtKernels.h), within 3.5% of
+// the root, after which three or four steps reach any of the tolerances.
+//
+// Every call stops after maxSqrtIterations steps, more than any double needs from either start, so a
+// rule that cannot be met ends there instead of running out of stack.
+
+enum class ToleranceMode
+{
+    Absolute, // |x_n+1 - x_n| < tolerance
+    Relative, // |x_n+1 - x_n| <= tolerance * x_n+1
+    Ulp,      // x_n+1 and x_n at most tolerance ulps apart
+};
+
+enum class SqrtStart
+{
+    Classic,  // 0.5 * (1 + a)
+    Exponent, // from the bits of a
+};
+
+struct SqrtOptions
+{
+    ToleranceMode mode = ToleranceMode::Absolute;
+    double tolerance = 1e-7;
+    SqrtStart start = SqrtStart::Classic;
+};
+
+constexpr int maxSqrtIterations = 1024;
+
+// Number of calls by iteration count: counts()[n] calls took n steps.
+class IterationHistogram
+{
+public:
+    void record(int iterations)
+    {
+        if (static_cast<std::size_t>(iterations) >= buckets.size()) buckets.resize(iterations + 1, 0);
+        buckets[iterations]++;
+        total++;
+        sum += iterations;
+    }
+
+    void clear()
+    {
+        buckets.clear();
+        total = 0;
+        sum = 0;
+    }
+
+    std::uint64_t calls() const { return total; }
+    double mean() const { return total ? static_cast<double>(sum) / total : 0; }
+    int max() const { return static_cast<int>(buckets.size()) - 1; }
+    const std::vector<std::uint64_t>& counts() const { return buckets; }
+
+    // Smallest n such that at least the fraction p of calls took n steps or fewer.
+    int percentile(double p) const
+    {
+        std::uint64_t seen = 0;
+        for (std::size_t n = 0; n < buckets.size(); n++)
+        {
+            seen += buckets[n];
+            if (seen >= p * total) return static_cast<int>(n);
+        }
+        return max();
+    }
+
+private:
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t total = 0;
+    std::uint64_t sum = 0;
+};
+
+namespace detail
+{
+    inline bool converged(double x_n, double x_n1, const SqrtOptions& options)
+    {
+        switch (options.mode)
+        {
+        case ToleranceMode::Absolute: return std::abs(x_n1 - x_n) < options.tolerance;
+        case ToleranceMode::Relative: return std::abs(x_n1 - x_n) <= options.tolerance * x_n1;
+        case ToleranceMode::Ulp: return static_cast<double>(ulpDistance(x_n1, x_n)) <= options.tolerance;
+        }
+        return true;
+    }
+
+    // Halving the exponent field halves the logarithm; the constant centres the error. Within 3.5% of
+    // sqrt(a) for normal a, and still a positive start for subnormal a.
+    inline double exponentGuess(double a)
+    {
+        return std::bit_cast<double>((std::bit_cast<std::uint64_t>(a) >> 1) + 0x1FF769E440000000ULL);
+    }
+} // namespace detail
+
+// Recursive step; iteration is the number of steps taken so far.
+inline double mySqrtRec(double a, double x_n, const SqrtOptions& options, int iteration, int* iterations)
+{
+    double x_n1 = 0.5 * (x_n + a / x_n);
+    iteration++;
+    if (iteration >= maxSqrtIterations || detail::converged(x_n, x_n1, options))
+    {
+        if (iterations) *iterations = iteration;
+        return x_n1;
+    }
+    return mySqrtRec(a, x_n1, options, iteration, iterations);
+}
+
+// sqrt(a) with the given stopping rule and start; the number of steps goes to histogram if one is given.
+// 0 and inf are returned as they are, without a step, and negative a or NaN give NaN.
+inline double mySqrt(double a, const SqrtOptions& options, IterationHistogram* histogram = nullptr)
+{
+    if (!(a > 0) || a == std::numeric_limits<double>::infinity())
+    {
+        if (histogram) histogram->record(0);
+        return a == 0 || a == std::numeric_limits<double>::infinity() ? a : std::numeric_limits<double>::quiet_NaN();
+    }
+    int iterations = 0;
+    double start = options.start == SqrtStart::Exponent ? detail::exponentGuess(a) : 0.5 * (1 + a);
+    double result = mySqrtRec(a, start, options, 0, &iterations);
+    if (histogram) histogram->record(iterations);
+    return result;
+}
+
+inline double mySqrt(double a, double epsilon = 1e-7)
+{
+    return mySqrt(a, SqrtOptions{ ToleranceMode::Absolute, epsilon });
+}
+
+#endif // MY_SQRT_H
@@ -0,0 +1,92 @@
+#include "../SqrtKernels.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// sqrtArray() at each precision against a std::sqrt loop: throughput over an array that stays in cache,
+// and the largest error in ulps over inputs spread log-uniformly across the whole double range,
+// subnormals included. Special values (0, -0, inf, NaN, negatives) must match std::sqrt exactly.
+// Usage: Lab1SqrtBench [array size] [passes]
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 4096);
+    std::size_t passes = bench::argOr(argc, argv, 2, 20000);
+    std::mt19937_64 gen(49);
+    std::uniform_real_distribution<double> exponentDist(-1074, 1023);
+    std::uniform_real_distribution<double> mantissaDist(1.0, 2.0);
+    auto randomPositive = [&] { return std::ldexp(mantissaDist(gen), static_cast<int>(exponentDist(gen))); };
+
+    // Throughput input: normal values, 1e-300 to 1e300. Subnormals are rare in practice and slow to
+    // multiply on most hardware.
+    std::uniform_real_distribution<double> decadeDist(-300, 300);
+    std::vector<double> in(n), out(n);
+    for (double& value : in) value = std::pow(10.0, decadeDist(gen));
+
+    double sum = 0;
+    double tStd = bench::measure([&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            for (std::size_t i = 0; i < n; ++i) out[i] = std::sqrt(in[i]);
+            sum += out[p % n];
+        }
+    });
+    std::cout << "array of " << n << " doubles, " << passes << " passes"
+#if defined(SQRT_KERNELS_AVX2)
+              << ", AVX2"
+#else
+              << ", scalar"
+#endif
+              << std::endl;
+    bench::report("std::sqrt", tStd, n * passes);
+
+    // Accuracy sample: log-uniform values plus the edges of the range.
+    std::vector<double> sample(1 << 20);
+    for (double& value : sample) value = randomPositive();
+    const double edges[] = { std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::min(),
+                             std::numeric_limits<double>::max(), 1.0, 2.0, 4.0, 0.25 };
+    std::copy(std::begin(edges), std::end(edges), sample.begin());
+    const double specials[] = { 0.0, -0.0, std::numeric_limits<double>::infinity(), -1.0,
+                                -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() };
+    std::vector<double> roots(sample.size());
+
+    int failed = 0;
+    const std::pair<const char*, SqrtPrecision> levels[] = {
+        { "Low", SqrtPrecision::Low }, { "Medium", SqrtPrecision::Medium }, { "Full", SqrtPrecision::Full } };
+    for (auto [name, precision] : levels) {
+        double t = bench::measure([&] {
+            for (std::size_t p = 0; p < passes; ++p) {
+                sqrtArray(in.data(), out.data(), n, precision);
+                sum += out[p % n];
+            }
+        });
+        bench::report(std::string("sqrtArray, ") + name, t, n * passes);
+
+        sqrtArray(sample.data(), roots.data(), sample.size(), precision);
+        std::uint64_t maxUlp = 0;
+        double maxRelative = 0;
+        for (std::size_t i = 0; i < sample.size(); ++i) {
+            double expected = std::sqrt(sample[i]);
+            maxUlp = std::max(maxUlp, ulpDistance(roots[i], expected));
+            maxRelative = std::max(maxRelative, std::abs(roots[i] - expected) / expected);
+        }
+        std::cout << "  max error " << maxUlp << " ulp, relative " << std::scientific << std::setprecision(2)
+                  << maxRelative << std::fixed << ", speed vs std::sqrt " << tStd / t << "x" << std::endl;
+
+        double specialRoots[std::size(specials)];
+        sqrtArray(specials, specialRoots, std::size(specials), precision);
+        for (std::size_t i = 0; i < std::size(specials); ++i) {
+            double expected = std::sqrt(specials[i]);
+            bool same = std::isnan(expected) ? std::isnan(specialRoots[i])
+                                             : std::bit_cast<std::uint64_t>(expected) == std::bit_cast<std::uint64_t>(specialRoots[i]);
+            if (!same) {
+                std::cerr << "  sqrt(" << specials[i] << ") gave " << specialRoots[i] << std::endl;
+                failed = 1;
+            }
+        }
+    }
+    bench::doNotOptimize(sum);
+    return failed;
+}
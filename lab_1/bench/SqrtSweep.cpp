@@ -0,0 +1,88 @@
+#include "../MySqrt.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+// mySqrt() under each stopping rule, and from the exponent start, over a from 1e-300 to 1e300: steps,
+// time per call and error against std::sqrt, first decade by decade, then as a histogram summary over
+// log-uniform random a.
+// Usage: Lab1SqrtSweep [random values] [decade step]
+namespace
+{
+    struct Mode
+    {
+        const char* name;
+        SqrtOptions options;
+    };
+
+    const Mode modes[] = {
+        { "absolute 1e-7", { ToleranceMode::Absolute, 1e-7 } },
+        { "relative 1e-8", { ToleranceMode::Relative, 1e-8 } },
+        { "1 ulp", { ToleranceMode::Ulp, 1 } },
+        { "relative 1e-8, exponent start", { ToleranceMode::Relative, 1e-8, SqrtStart::Exponent } },
+    };
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t samples = bench::argOr(argc, argv, 1, 100000);
+    int decadeStep = static_cast<int>(bench::argOr(argc, argv, 2, 25));
+
+    std::cout << std::left << std::setw(10) << "a";
+    for (const Mode& mode : modes) std::cout << std::setw(34) << mode.name;
+    std::cout << std::endl << std::setw(10) << "";
+    for (std::size_t m = 0; m < std::size(modes); ++m) std::cout << std::setw(34) << "steps     ns/call   error (ulp)";
+    std::cout << std::endl;
+
+    for (int decade = -300; decade <= 300; decade += decadeStep) {
+        double a = std::pow(10.0, decade);
+        std::cout << std::left << std::setw(10) << ("1e" + std::to_string(decade));
+        for (const Mode& mode : modes) {
+            IterationHistogram histogram;
+            double root = mySqrt(a, mode.options, &histogram);
+            const int calls = 200;
+            double sum = 0;
+            double seconds = bench::measure([&] {
+                for (int i = 0; i < calls; ++i) sum += mySqrt(a * (1 + i * 1e-6), mode.options);
+            });
+            bench::doNotOptimize(sum);
+            std::uint64_t ulps = ulpDistance(root, std::sqrt(a));
+            std::cout << std::right << std::setw(5) << histogram.max() << std::setw(12) << std::fixed << std::setprecision(1)
+                      << seconds / calls * 1e9 << std::setw(14) << (ulps > 999999999 ? std::string(">1e9") : std::to_string(ulps))
+                      << std::setw(3) << "" << std::left;
+        }
+        std::cout << std::endl;
+    }
+
+    std::mt19937_64 gen(50);
+    std::uniform_real_distribution<double> decadeDist(-300, 300);
+    std::vector<double> values(samples);
+    for (double& value : values) value = std::pow(10.0, decadeDist(gen));
+
+    std::cout << std::endl << samples << " values, log-uniform in [1e-300, 1e300]:" << std::endl;
+    for (const Mode& mode : modes) {
+        IterationHistogram histogram;
+        std::uint64_t maxUlp = 0;
+        std::size_t exact = 0;
+        double sum = 0;
+        double seconds = bench::measure([&] {
+            for (double a : values) sum += mySqrt(a, mode.options, &histogram);
+        });
+        bench::doNotOptimize(sum);
+        for (double a : values) {
+            std::uint64_t ulps = ulpDistance(mySqrt(a, mode.options), std::sqrt(a));
+            maxUlp = std::max(maxUlp, ulps);
+            exact += ulps == 0;
+        }
+        std::cout << "  " << std::left << std::setw(32) << mode.name << std::right << std::fixed << std::setprecision(1)
+                  << "steps mean " << histogram.mean() << ", median " << histogram.percentile(0.5)
+                  << ", p99 " << histogram.percentile(0.99) << ", max " << histogram.max()
+                  << (histogram.max() >= maxSqrtIterations ? " (cap)" : "")
+                  << "; " << seconds / samples * 1e9 << " ns/call; exact " << 100.0 * exact / samples
+                  << "%, max error " << (maxUlp > 999999999 ? std::string(">1e9") : std::to_string(maxUlp)) << " ulp" << std::endl;
+    }
+    return 0;
+}
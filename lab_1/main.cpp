@@ -1,5 +1,7 @@
 #include <iostream>
 #include <cmath>
+#include <utility>
+#include "MySqrt.h"
 
 using namespace std;
 
@@ -43,21 +45,21 @@ bool checkSqrtDomain(const double& value)
     return true; //  true,   
 }
 
-//      
-double mySqrtRec(double a, double x_n, double epsilon)
+//           
+void printIterations(double a)
 {
-    double x_n1 = 0.5 * (x_n + a / x_n); //   
-    if (abs(x_n1 - x_n) < epsilon) //   
+    const pair<const char*, SqrtOptions> modes[] = {
+        { "  1e-7", { ToleranceMode::Absolute, 1e-7 } },
+        { "  1e-8", { ToleranceMode::Relative, 1e-8 } },
+        { "   1 ULP", { ToleranceMode::Ulp, 1 } },
+        { "  1e-8,   ", { ToleranceMode::Relative, 1e-8, SqrtStart::Exponent } },
+    };
+    for (const auto& [name, options] : modes)
     {
-        return x_n1; //  ,   
+        IterationHistogram histogram; //   :    
+        double result = mySqrt(a, options, &histogram);
+        cout << name << ": " << result << " (: " << histogram.max() << ")" << endl;
     }
-    return mySqrtRec(a, x_n1, epsilon); //      
-}
-
-//        
-double mySqrt(double a, double epsilon = 1e-7)
-{
-    return mySqrtRec(a, 0.5 * (1 + a), epsilon); //      
 }
 
 //    
@@ -79,6 +81,11 @@ void calculate()
     cout << sqrt(a) << endl; //     sqrt
 
     cout << endl;
+
+    cout << "  :" << endl;
+    printIterations(a); //       
+
+    cout << endl;
 }
 
 int main()
@@ -0,0 +1,134 @@
+#ifndef BATCH_EVAL_H
+#define BATCH_EVAL_H
+
+#include "Bytecode.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BATCH_EVAL_AVX2
+#endif
+
+// Evaluation of one compiled expression over many rows of variable values at once.
+//
+// The input is structure-of-arrays: one column of doubles per variable. Instead of running the whole
+// program per row, evaluateBatch() runs each instruction across a block of rows, so every step is a
+// tight loop over contiguous arrays -- four rows per instruction with AVX2, whatever the compiler makes
+// of the plain loop otherwise. A load pushes a pointer into the variable's column rather than copying it;
+// only operator results are written, each into the block-sized buffer of its stack level.
+//
+// Division by zero does not stop the batch: the rows where evaluateRPN() would have thrown are flagged
+// in a mask and get NaN as their result. Up to the first division by zero a row goes through exactly the
+// same operations as in evaluateRPN(), so the flags match it row for row.
+
+// The column of each variable, indexed by variableSlot(); columns the program does not read may be null.
+using Columns = std::array<const double*, variableSlots>;
+
+namespace detail
+{
+    enum class Kernel { Add, Subtract, Multiply, Divide };
+
+    template <Kernel K>
+    inline double apply(double a, double b) {
+        if constexpr (K == Kernel::Add) return a + b;
+        else if constexpr (K == Kernel::Subtract) return a - b;
+        else if constexpr (K == Kernel::Multiply) return a * b;
+        else return a / b;
+    }
+
+#if defined(BATCH_EVAL_AVX2)
+    template <Kernel K>
+    inline __m256d apply(__m256d a, __m256d b) {
+        if constexpr (K == Kernel::Add) return _mm256_add_pd(a, b);
+        else if constexpr (K == Kernel::Subtract) return _mm256_sub_pd(a, b);
+        else if constexpr (K == Kernel::Multiply) return _mm256_mul_pd(a, b);
+        else return _mm256_div_pd(a, b);
+    }
+#endif
+
+    // out[i] = a[i] op b[i]; out may be a. For division, zero[i] is set where b[i] == 0.
+    template <Kernel K>
+    inline void run(const double* a, const double* b, double* out, std::uint8_t* zero, std::size_t n) {
+        std::size_t i = 0;
+#if defined(BATCH_EVAL_AVX2)
+        for (; i + 4 <= n; i += 4) {
+            __m256d vb = _mm256_loadu_pd(b + i);
+            if constexpr (K == Kernel::Divide) {
+                int bits = _mm256_movemask_pd(_mm256_cmp_pd(vb, _mm256_setzero_pd(), _CMP_EQ_OQ));
+                if (bits) {
+                    for (int lane = 0; lane < 4; lane++) zero[i + lane] |= (bits >> lane) & 1;
+                }
+            }
+            _mm256_storeu_pd(out + i, apply<K>(_mm256_loadu_pd(a + i), vb));
+        }
+#endif
+        for (; i < n; i++) {
+            if constexpr (K == Kernel::Divide) zero[i] |= b[i] == 0;
+            out[i] = apply<K>(a[i], b[i]);
+        }
+    }
+
+    inline void run(OpCode op, const double* a, const double* b, double* out, std::uint8_t* zero, std::size_t n) {
+        switch (op) {
+        case OpCode::Add: case OpCode::AddVar: run<Kernel::Add>(a, b, out, zero, n); break;
+        case OpCode::Subtract: case OpCode::SubtractVar: run<Kernel::Subtract>(a, b, out, zero, n); break;
+        case OpCode::Multiply: case OpCode::MultiplyVar: run<Kernel::Multiply>(a, b, out, zero, n); break;
+        case OpCode::Divide: case OpCode::DivideVar: run<Kernel::Divide>(a, b, out, zero, n); break;
+        case OpCode::Load: break;
+        }
+    }
+} // namespace detail
+
+// Evaluates rows [0, rows). out[i] gets row i's value; divisionByZero[i] is 1 where evaluateRPN() would
+// have thrown "Division by zero" (out[i] is then NaN) and 0 elsewhere. Throws std::invalid_argument if
+// the program reads a variable whose column is null.
+inline void evaluateBatch(const Program& program, const Columns& columns, std::size_t rows,
+                          double* out, std::uint8_t* divisionByZero) {
+    for (Instruction in : program.code) {
+        if (in.op >= OpCode::AddVar || in.op == OpCode::Load) {
+            if (!columns[in.slot]) throw std::invalid_argument("evaluateBatch: no column for a variable the expression uses");
+        }
+    }
+    std::memset(divisionByZero, 0, rows);
+
+    // Rows per pass: the stack buffers of a block stay in L1/L2 between instructions.
+    constexpr std::size_t block = 512;
+    std::vector<double> scratch(std::max<std::size_t>(program.stackDepth, 1) * block);
+    std::vector<const double*> stack(program.stackDepth);
+
+    for (std::size_t first = 0; first < rows; first += block) {
+        std::size_t n = std::min(block, rows - first);
+        std::uint8_t* zero = divisionByZero + first;
+        std::size_t top = 0; // number of values on the stack
+        for (Instruction in : program.code) {
+            if (in.op == OpCode::Load) {
+                stack[top++] = columns[in.slot] + first;
+                continue;
+            }
+            const double* b;
+            if (in.op >= OpCode::AddVar) {
+                b = columns[in.slot] + first;
+            }
+            else {
+                b = stack[--top];
+            }
+            double* result = scratch.data() + (top - 1) * block;
+            detail::run(in.op, stack[top - 1], b, result, zero, n);
+            stack[top - 1] = result;
+        }
+        std::memcpy(out + first, stack[0], n * sizeof(double));
+        for (std::size_t i = 0; i < n; i++) {
+            if (zero[i]) out[first + i] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+}
+
+#endif // BATCH_EVAL_H
@@ -0,0 +1,232 @@
+#ifndef BATCH_SERVER_H
+#define BATCH_SERVER_H
+
+#include "Optimizer.h"
+#include "Parser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Non-interactive evaluation of a stream of records, one per line:
+//
+//     <expression> ; <name>=<value> <name>=<value> ...
+//
+// e.g. "a * b + sqrt(c); a=1 b=2.5 c=9". Bindings are separated by spaces or commas; the part after ';'
+// may be missing for an expression without variables. Blank lines and lines starting with '#' are
+// skipped.
+//
+// readRecords() goes through the input once, on one thread: each distinct expression text is parsed and
+// optimized the first time it is seen and taken from the cache after that, and each record's values are
+// stored in the order of its expression's variables. evaluateRecords() then splits the records into
+// chunks that worker threads take in turn, each with its own scratch array, and writes every result to
+// the record's own slot -- so the output is in input order whatever the number of threads.
+
+struct CompiledExpression {
+    Expression expression; // parsed and optimized; empty if the text did not parse
+    std::string error;
+};
+
+class ExpressionCache {
+public:
+    // The compiled form of the text, parsing it on first use. The reference stays valid for the
+    // lifetime of the cache.
+    const CompiledExpression& get(std::string_view text) {
+        auto it = entries.find(text);
+        if (it != entries.end()) {
+            hitCount++;
+            return *it->second;
+        }
+        auto entry = std::make_unique<CompiledExpression>();
+        try {
+            entry->expression = optimize(parseExpression(text));
+            maxNodes = std::max(maxNodes, entry->expression.nodes.size());
+        }
+        catch (const std::exception& e) {
+            entry->error = e.what();
+        }
+        return *entries.emplace(std::string(text), std::move(entry)).first->second;
+    }
+
+    std::size_t size() const { return entries.size(); }
+    std::size_t hits() const { return hitCount; }
+
+    // Scratch space evaluate() needs for any cached expression.
+    std::size_t scratchSize() const { return maxNodes; }
+
+private:
+    // Lets entries be searched with a string_view without building a std::string.
+    struct TextHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+
+    std::unordered_map<std::string, std::unique_ptr<CompiledExpression>, TextHash, std::equal_to<>> entries;
+    std::size_t hitCount = 0;
+    std::size_t maxNodes = 0;
+};
+
+struct Record {
+    const CompiledExpression* compiled;
+    std::size_t firstValue; // values of compiled->expression.variables, from RecordBatch::values
+    std::string error;      // set if the record cannot be evaluated: bad syntax, bad or missing bindings
+};
+
+struct RecordBatch {
+    ExpressionCache cache;
+    std::vector<Record> records;
+    std::vector<double> values;
+};
+
+struct RecordResult {
+    double value = 0;
+    std::string error; // empty on success
+};
+
+namespace detail
+{
+    inline std::string_view trim(std::string_view text) {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+        return text;
+    }
+
+    inline bool isSeparator(char ch) {
+        return ch == ',' || std::isspace(static_cast<unsigned char>(ch));
+    }
+
+    // Fills the record's values from "name=value ..." or sets its error.
+    inline void bindRecord(std::string_view bindings, RecordBatch& batch, Record& record,
+                           std::vector<std::pair<std::string_view, double>>& pairs) {
+        pairs.clear();
+        std::size_t pos = 0;
+        while (true) {
+            while (pos < bindings.size() && isSeparator(bindings[pos])) pos++;
+            if (pos == bindings.size()) break;
+            std::size_t end = pos;
+            while (end < bindings.size() && !isSeparator(bindings[end])) end++;
+            std::string_view binding = bindings.substr(pos, end - pos);
+            std::size_t equals = binding.find('=');
+            double value = 0;
+            if (equals == std::string_view::npos || equals == 0 ||
+                std::from_chars(binding.data() + equals + 1, binding.data() + binding.size(), value).ptr != binding.data() + binding.size()) {
+                record.error = "Error: Invalid binding '" + std::string(binding) + "'.";
+                return;
+            }
+            pairs.emplace_back(binding.substr(0, equals), value);
+            pos = end;
+        }
+        const std::vector<std::string>& variables = record.compiled->expression.variables;
+        for (const std::string& name : variables) {
+            // Records bind a handful of variables, so a linear search beats building a map per record.
+            auto it = std::find_if(pairs.begin(), pairs.end(), [&](const auto& pair) { return pair.first == name; });
+            if (it == pairs.end()) {
+                record.error = "Error: No value for variable '" + name + "'.";
+                batch.values.resize(record.firstValue);
+                return;
+            }
+            batch.values.push_back(it->second);
+        }
+    }
+} // namespace detail
+
+inline RecordBatch readRecords(std::string_view text) {
+    RecordBatch batch;
+    std::vector<std::pair<std::string_view, double>> pairs;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view line = detail::trim(text.substr(start, end - start));
+        start = end + 1;
+        if (line.empty() || line.front() == '#') continue;
+
+        std::size_t semicolon = line.find(';');
+        std::string_view source = detail::trim(line.substr(0, semicolon));
+        Record& record = batch.records.emplace_back();
+        record.compiled = &batch.cache.get(source);
+        record.firstValue = batch.values.size();
+        if (!record.compiled->error.empty()) {
+            record.error = record.compiled->error;
+            continue;
+        }
+        std::string_view bindings = semicolon == std::string_view::npos ? std::string_view() : line.substr(semicolon + 1);
+        detail::bindRecord(bindings, batch, record, pairs);
+    }
+    return batch;
+}
+
+inline RecordBatch readRecords(std::istream& in) {
+    std::string text(std::istreambuf_iterator<char>(in), {});
+    return readRecords(std::string_view(text));
+}
+
+// results[i] gets the value of batch.records[i], or its error. threads == 0 means one per hardware thread.
+inline void evaluateRecords(const RecordBatch& batch, std::vector<RecordResult>& results, unsigned threads = 0) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    results.resize(batch.records.size());
+    constexpr std::size_t chunk = 1024;
+    std::size_t chunks = (batch.records.size() + chunk - 1) / chunk;
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(chunks, 1)));
+    std::atomic<std::size_t> next{ 0 };
+
+    auto work = [&] {
+        std::vector<double> scratch(batch.cache.scratchSize());
+        for (std::size_t c = next++; c < chunks; c = next++) {
+            std::size_t last = std::min(batch.records.size(), (c + 1) * chunk);
+            for (std::size_t i = c * chunk; i < last; i++) {
+                const Record& record = batch.records[i];
+                RecordResult& result = results[i];
+                if (!record.error.empty()) {
+                    result.error = record.error;
+                    continue;
+                }
+                try {
+                    result.error.clear();
+                    result.value = evaluate(record.compiled->expression, batch.values.data() + record.firstValue, scratch.data());
+                }
+                catch (const std::exception& e) {
+                    result.error = e.what();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) workers.emplace_back(work);
+    work();
+    for (std::thread& worker : workers) worker.join();
+}
+
+// One line per record: the shortest text that reads back as the same double, or the error message.
+inline void writeResults(std::ostream& out, const std::vector<RecordResult>& results) {
+    std::string buffer;
+    buffer.reserve(results.size() * 24);
+    char number[32];
+    for (const RecordResult& result : results) {
+        if (result.error.empty()) {
+            buffer.append(number, std::to_chars(number, number + sizeof(number), result.value).ptr);
+        }
+        else {
+            buffer += result.error;
+        }
+        buffer += '\n';
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+#endif // BATCH_SERVER_H
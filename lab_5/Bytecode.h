@@ -0,0 +1,122 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compile-once, evaluate-many form of an RPN expression.
+//
+// compileRPN() reads the output of infixToRPN() once: variables become indices into a fixed array of
+// values, operators become opcodes, and the stack depth the expression needs is worked out up front.
+// An operator whose right operand is a plain variable is fused with the load of that variable, which
+// roughly halves the number of instructions for typical formulas. evaluate() then runs the program
+// over a Bindings array with no parsing, no hashing and no allocation.
+
+enum class OpCode : std::uint8_t {
+    Load,                                   // push values[slot]
+    Add, Subtract, Multiply, Divide,        // pop b, pop a, push a op b
+    AddVar, SubtractVar, MultiplyVar, DivideVar, // pop a, push a op values[slot]
+};
+
+struct Instruction {
+    OpCode op;
+    std::uint8_t slot;
+};
+
+// Variables a..z take slots 0..25, A..Z slots 26..51.
+constexpr std::size_t variableSlots = 52;
+
+using Bindings = std::array<double, variableSlots>;
+
+constexpr std::size_t variableSlot(char name) {
+    if (name >= 'a' && name <= 'z') return static_cast<std::size_t>(name - 'a');
+    if (name >= 'A' && name <= 'Z') return static_cast<std::size_t>(name - 'A' + 26);
+    throw std::invalid_argument(std::string("Error: Unknown variable '") + name + "'.");
+}
+
+struct Program {
+    std::vector<Instruction> code;
+    std::size_t stackDepth = 0;
+};
+
+// Throws std::runtime_error with the same messages as evaluateRPN() for malformed input.
+inline Program compileRPN(const std::string& rpn) {
+    Program program;
+    std::size_t depth = 0;
+    std::stringstream tokens(rpn);
+    std::string token;
+    while (tokens >> token) {
+        if (std::isalpha(static_cast<unsigned char>(token[0]))) {
+            program.code.push_back({ OpCode::Load, static_cast<std::uint8_t>(variableSlot(token[0])) });
+            program.stackDepth = std::max(program.stackDepth, ++depth);
+            continue;
+        }
+        if (depth < 2) {
+            throw std::runtime_error("Error: Malformed expression.");
+        }
+        OpCode op;
+        switch (token[0]) {
+        case '+': op = OpCode::Add; break;
+        case '-': op = OpCode::Subtract; break;
+        case '*': op = OpCode::Multiply; break;
+        case '/': op = OpCode::Divide; break;
+        default: throw std::runtime_error("Error: Unknown operator.");
+        }
+        depth--;
+        Instruction& last = program.code.back();
+        if (last.op == OpCode::Load) {
+            // The opcodes with a variable operand follow the plain ones in the same order.
+            last.op = static_cast<OpCode>(static_cast<int>(op) + static_cast<int>(OpCode::AddVar) - static_cast<int>(OpCode::Add));
+        }
+        else {
+            program.code.push_back({ op, 0 });
+        }
+    }
+    if (depth != 1) {
+        throw std::runtime_error("Error: Malformed expression.");
+    }
+    return program;
+}
+
+// Runs the program with `stack` as scratch space, which must hold program.stackDepth values.
+inline double evaluate(const Program& program, const Bindings& values, double* stack) {
+    double* top = stack - 1;
+    auto divide = [](double a, double b) {
+        if (b == 0) throw std::runtime_error("Error: Division by zero.");
+        return a / b;
+    };
+    for (Instruction in : program.code) {
+        switch (in.op) {
+        case OpCode::Load: *++top = values[in.slot]; break;
+        case OpCode::Add: top[-1] += top[0]; --top; break;
+        case OpCode::Subtract: top[-1] -= top[0]; --top; break;
+        case OpCode::Multiply: top[-1] *= top[0]; --top; break;
+        case OpCode::Divide: top[-1] = divide(top[-1], top[0]); --top; break;
+        case OpCode::AddVar: *top += values[in.slot]; break;
+        case OpCode::SubtractVar: *top -= values[in.slot]; break;
+        case OpCode::MultiplyVar: *top *= values[in.slot]; break;
+        case OpCode::DivideVar: *top = divide(*top, values[in.slot]); break;
+        }
+    }
+    return stack[0];
+}
+
+// Same, with the scratch stack on the machine stack unless the expression is unusually deep.
+inline double evaluate(const Program& program, const Bindings& values) {
+    constexpr std::size_t inlineDepth = 64;
+    if (program.stackDepth <= inlineDepth) {
+        double stack[inlineDepth];
+        return evaluate(program, values, stack);
+    }
+    std::vector<double> stack(program.stackDepth);
+    return evaluate(program, values, stack.data());
+}
+
+#endif // BYTECODE_H
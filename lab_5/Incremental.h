@@ -0,0 +1,163 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "Parser.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Re-evaluation of one expression while its variables change a few at a time.
+//
+// IncrementalEvaluator keeps the value of every node from the last evaluation. At construction it works
+// out, for each variable, the nodes whose value depends on it -- the variable's own nodes and all their
+// ancestors -- as a list in node order. set() only records which variables changed; value() then
+// recomputes just the nodes on their lists, operands before parents, and reads the root. When one
+// variable changes, that is a walk down one precomputed list; several changed variables have their lists
+// merged first. Everything else, constants and subterms over unchanged variables, is not touched.
+//
+// Works on the output of parseExpression() and of optimize() alike: a node shared by several parents is
+// on a variable's list once.
+
+class IncrementalEvaluator {
+public:
+    // variables[i] is the starting value of expression.variables[i]. Nothing is evaluated yet: the first
+    // value() computes every node.
+    IncrementalEvaluator(Expression expression, const std::vector<double>& variables)
+        : expression(std::move(expression)), variables(variables),
+          values(this->expression.nodes.size()), changed(variables.size(), 0), marked(values.size(), 0) {
+        if (variables.size() != this->expression.variables.size()) {
+            throw std::invalid_argument("IncrementalEvaluator: expected a value for each variable");
+        }
+        buildDependents();
+    }
+
+    void set(std::size_t variable, double value) {
+        // Bitwise, so that 0 -> -0 still counts as a change and NaN -> NaN does not.
+        if (std::bit_cast<std::uint64_t>(variables[variable]) == std::bit_cast<std::uint64_t>(value)) return;
+        variables[variable] = value;
+        if (!changed[variable]) {
+            changed[variable] = 1;
+            pending.push_back(static_cast<std::uint32_t>(variable));
+        }
+    }
+
+    double get(std::size_t variable) const { return variables[variable]; }
+
+    // Brings the dirty nodes up to date and returns the root's value. Throws "Division by zero" like
+    // evaluate(); the nodes that were not recomputed stay dirty, so the next call retries them.
+    double value() {
+        if (full) {
+            lastRecomputed = expression.nodes.size();
+            evaluate(expression, variables.data(), values.data());
+            full = false;
+            clearPending();
+        }
+        else if (pending.size() == 1) {
+            const std::vector<std::uint32_t>& nodes = dependents[pending[0]];
+            lastRecomputed = nodes.size();
+            recompute(nodes);
+            clearPending();
+        }
+        else if (!pending.empty()) {
+            merged.clear();
+            for (std::uint32_t variable : pending) {
+                for (std::uint32_t node : dependents[variable]) {
+                    if (marked[node]) continue;
+                    marked[node] = 1;
+                    merged.push_back(node);
+                }
+            }
+            for (std::uint32_t node : merged) marked[node] = 0;
+            std::sort(merged.begin(), merged.end());
+            lastRecomputed = merged.size();
+            recompute(merged);
+            clearPending();
+        }
+        else {
+            lastRecomputed = 0;
+        }
+        return values[expression.root()];
+    }
+
+    // Nodes recomputed by the last value() call.
+    std::size_t recomputed() const { return lastRecomputed; }
+
+    // Nodes that depend on the variable, i.e. the work of a value() after changing it alone.
+    std::size_t dependentCount(std::size_t variable) const { return dependents[variable].size(); }
+
+private:
+    Expression expression;
+    std::vector<double> variables;
+    std::vector<double> values;                      // per node, as of the last value()
+    std::vector<std::vector<std::uint32_t>> dependents; // per variable, ascending node indices
+    std::vector<std::uint32_t> pending;              // variables set since the last value()
+    std::vector<char> changed;                       // per variable: in pending
+    std::vector<std::uint32_t> merged;
+    std::vector<char> marked;                        // per node, scratch for merging
+    std::size_t lastRecomputed = 0;
+    bool full = true;
+
+    // A node depends on a variable if one of its operands does. Walking up from the variable's nodes
+    // through a parent index touches each dependent node once per variable, so the cost is the total
+    // size of the lists rather than nodes times variables.
+    void buildDependents() {
+        const std::vector<Node>& nodes = expression.nodes;
+        std::vector<std::uint32_t> parentStart(nodes.size() + 1, 0), parents;
+        auto forEachOperand = [&](std::size_t i, auto&& fn) {
+            const Node& node = nodes[i];
+            if (node.kind == NodeKind::Number || node.kind == NodeKind::Variable) return;
+            fn(node.left);
+            bool second = isBinary(node.kind) || (node.kind == NodeKind::Call && functionInfo(node.function).arity == 2);
+            if (second && node.right != node.left) fn(node.right);
+        };
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            forEachOperand(i, [&](std::uint32_t operand) { parentStart[operand + 1]++; });
+        }
+        for (std::size_t i = 0; i < nodes.size(); i++) parentStart[i + 1] += parentStart[i];
+        parents.resize(parentStart.back());
+        std::vector<std::uint32_t> fill(parentStart.begin(), parentStart.end() - 1);
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            forEachOperand(i, [&](std::uint32_t operand) { parents[fill[operand]++] = static_cast<std::uint32_t>(i); });
+        }
+
+        dependents.resize(variables.size());
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            if (nodes[i].kind == NodeKind::Variable) dependents[nodes[i].left].push_back(static_cast<std::uint32_t>(i));
+        }
+        std::vector<std::uint32_t> work;
+        for (std::vector<std::uint32_t>& list : dependents) {
+            // The list starts as the variable's own nodes and grows into everything above them.
+            work.assign(list.begin(), list.end());
+            list.clear();
+            while (!work.empty()) {
+                std::uint32_t node = work.back();
+                work.pop_back();
+                if (marked[node]) continue;
+                marked[node] = 1;
+                list.push_back(node);
+                for (std::uint32_t p = parentStart[node]; p < parentStart[node + 1]; p++) work.push_back(parents[p]);
+            }
+            for (std::uint32_t node : list) marked[node] = 0;
+            std::sort(list.begin(), list.end());
+        }
+    }
+
+    void recompute(const std::vector<std::uint32_t>& nodes) {
+        for (std::uint32_t i : nodes) {
+            const Node& node = expression.nodes[i];
+            if (node.kind == NodeKind::Variable) values[i] = variables[node.left];
+            else values[i] = applyNode(node, values[node.left], values[node.right]);
+        }
+    }
+
+    void clearPending() {
+        for (std::uint32_t variable : pending) changed[variable] = 0;
+        pending.clear();
+    }
+};
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,182 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "Parser.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// Optimization pass over a parsed Expression. It walks the nodes once, operands first, and for each
+// node:
+//
+//   - folds it to a Number if all its operands are numbers (a division by zero is left in place, so the
+//     error still comes at evaluation time);
+//   - drops identities: x*1, 1*x, x/1, x+0, 0+x, x-0, x^1 and -(-x) become x;
+//   - shares it with an identical node built earlier (hash-consing), treating the operands of + and *
+//     as unordered, so every repeated subterm is computed once.
+//
+// The result is a DAG in the same flat form -- shared nodes are simply referenced by several parents --
+// so evaluate() runs it unchanged; toRPN() prints a shared node only once. The rewrites give
+// bit-identical results with one exception: x+0 is +0 for x = -0, so dropping it can flip the sign of a
+// zero, which shows only where a later operation looks at that sign (a negative power of it, or min/max
+// against the other zero). x*0 is deliberately not rewritten: it is NaN for infinite or NaN x.
+
+struct OptimizeStats {
+    std::size_t operationsBefore = 0; // nodes other than numbers and variables
+    std::size_t operationsAfter = 0;
+    std::size_t folded = 0;           // operations replaced by their constant value
+    std::size_t simplified = 0;       // operations removed as identities
+    std::size_t shared = 0;           // operations found to repeat an earlier one
+};
+
+namespace detail
+{
+    inline bool isOperation(NodeKind kind) {
+        return kind != NodeKind::Number && kind != NodeKind::Variable;
+    }
+
+    // Exactly, zero signs included; fmin(-0, 0) and fmin(0, -0) may differ, so min and max are not.
+    inline bool isCommutative(const Node& node) {
+        return node.kind == NodeKind::Add || node.kind == NodeKind::Multiply;
+    }
+
+    inline bool hasSecondOperand(const Node& node) {
+        return isBinary(node.kind) || (node.kind == NodeKind::Call && functionInfo(node.function).arity == 2);
+    }
+
+    struct NodeKey {
+        NodeKind kind;
+        Function function;
+        std::uint32_t left;
+        std::uint32_t right;
+        std::uint64_t bits; // the value of a Number, bit for bit, so 0 and -0 stay apart
+
+        bool operator==(const NodeKey&) const = default;
+    };
+
+    struct NodeKeyHash {
+        std::size_t operator()(const NodeKey& key) const {
+            std::uint64_t h = static_cast<std::uint64_t>(key.kind) | static_cast<std::uint64_t>(key.function) << 8;
+            h = (h ^ key.left) * 0x9E3779B97F4A7C15ULL;
+            h = (h ^ key.right) * 0x9E3779B97F4A7C15ULL;
+            h = (h ^ key.bits) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+    };
+} // namespace detail
+
+inline Expression optimize(const Expression& expression, OptimizeStats* stats = nullptr) {
+    OptimizeStats counts;
+    Expression result;
+    result.variables = expression.variables;
+    std::vector<std::uint32_t> mapped(expression.nodes.size()); // old node -> new node
+    std::unordered_map<detail::NodeKey, std::uint32_t, detail::NodeKeyHash> existing;
+    existing.reserve(expression.nodes.size());
+
+    auto isNumber = [&](std::uint32_t index, double value) {
+        const Node& node = result.nodes[index];
+        return node.kind == NodeKind::Number && node.value == value;
+    };
+    auto intern = [&](const Node& node) {
+        detail::NodeKey key{ node.kind, node.function, node.left, node.right, 0 };
+        if (node.kind == NodeKind::Number) std::memcpy(&key.bits, &node.value, sizeof(key.bits));
+        auto [it, added] = existing.emplace(key, static_cast<std::uint32_t>(result.nodes.size()));
+        if (added) result.nodes.push_back(node);
+        else if (detail::isOperation(node.kind)) counts.shared++;
+        return it->second;
+    };
+
+    for (std::size_t i = 0; i < expression.nodes.size(); i++) {
+        Node node = expression.nodes[i];
+        if (node.kind == NodeKind::Number || node.kind == NodeKind::Variable) {
+            node.right = 0;
+            if (node.kind == NodeKind::Variable) node.value = 0;
+            mapped[i] = intern(node);
+            continue;
+        }
+        counts.operationsBefore++;
+        bool binary = detail::hasSecondOperand(node);
+        node.left = mapped[node.left];
+        node.right = binary ? mapped[node.right] : 0;
+        node.value = 0;
+        if (node.kind != NodeKind::Call) node.function = Function::Sqrt;
+
+        const Node& a = result.nodes[node.left];
+        if (a.kind == NodeKind::Number && (!binary || result.nodes[node.right].kind == NodeKind::Number)) {
+            double b = binary ? result.nodes[node.right].value : 0;
+            bool divisionByZero = node.kind == NodeKind::Divide && b == 0;
+            if (!divisionByZero) {
+                Node folded{ NodeKind::Number };
+                folded.value = applyNode(node, a.value, b);
+                mapped[i] = intern(folded);
+                counts.folded++;
+                continue;
+            }
+        }
+
+        std::uint32_t same = UINT32_MAX;
+        switch (node.kind) {
+        case NodeKind::Add:
+            if (isNumber(node.right, 0)) same = node.left;
+            else if (isNumber(node.left, 0)) same = node.right;
+            break;
+        case NodeKind::Subtract:
+            if (isNumber(node.right, 0)) same = node.left;
+            break;
+        case NodeKind::Multiply:
+            if (isNumber(node.right, 1)) same = node.left;
+            else if (isNumber(node.left, 1)) same = node.right;
+            break;
+        case NodeKind::Divide:
+        case NodeKind::Power:
+            if (isNumber(node.right, 1)) same = node.left;
+            break;
+        case NodeKind::Negate:
+            if (a.kind == NodeKind::Negate) same = a.left;
+            break;
+        default:
+            break;
+        }
+        if (same != UINT32_MAX) {
+            mapped[i] = same;
+            counts.simplified++;
+            continue;
+        }
+
+        if (detail::isCommutative(node) && node.left > node.right) std::swap(node.left, node.right);
+        mapped[i] = intern(node);
+    }
+
+    // Folding and identities leave nodes nothing refers to any more: keep only what the root reaches.
+    std::uint32_t root = mapped[expression.root()];
+    std::vector<char> reachable(result.nodes.size(), 0);
+    reachable[root] = 1;
+    for (std::size_t i = result.nodes.size(); i-- > 0;) {
+        if (!reachable[i] || !detail::isOperation(result.nodes[i].kind)) continue;
+        reachable[result.nodes[i].left] = 1;
+        if (detail::hasSecondOperand(result.nodes[i])) reachable[result.nodes[i].right] = 1;
+    }
+    std::vector<std::uint32_t> renumbered(result.nodes.size());
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < result.nodes.size(); i++) {
+        if (!reachable[i]) continue;
+        Node node = result.nodes[i];
+        if (detail::isOperation(node.kind)) {
+            node.left = renumbered[node.left];
+            if (detail::hasSecondOperand(node)) node.right = renumbered[node.right];
+            counts.operationsAfter++;
+        }
+        renumbered[i] = static_cast<std::uint32_t>(kept);
+        result.nodes[kept++] = node;
+    }
+    // Every node reached is below the root, so the root is still the last one.
+    result.nodes.resize(kept);
+
+    if (stats) *stats = counts;
+    return result;
+}
+
+#endif // OPTIMIZER_H
@@ -0,0 +1,343 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Tokenizer and parser for the full expression language:
+//
+//     numbers      2, 0.5, .5, 1e-3
+//     variables    any identifier, e.g. x, speed, a1
+//     operators    + - * / and ^ (power, right-associative), unary minus and plus
+//     functions    sqrt abs exp log sin cos (one argument), min max pow (two)
+//     parentheses
+//
+// Precedence from loosest to tightest: + -, * /, unary minus, ^. So -a^2 is -(a^2) and a-b-c is
+// (a-b)-c, as in infixToRPN().
+//
+// parseExpression() reads the text in one pass and builds the tree bottom-up with explicit operator and
+// operand stacks, so nesting depth costs heap, not call stack, and a million-token expression parses
+// in linear time. The result is a flat array of nodes in which every node comes after its operands;
+// evaluating is a single loop over it.
+
+enum class NodeKind : std::uint8_t {
+    Number, Variable, Negate, Add, Subtract, Multiply, Divide, Power, Call,
+};
+
+enum class Function : std::uint8_t {
+    Sqrt, Abs, Exp, Log, Sin, Cos, Min, Max, Pow,
+};
+
+struct FunctionInfo {
+    std::string_view name;
+    Function function;
+    unsigned arity;
+};
+
+inline constexpr FunctionInfo functionTable[] = {
+    { "sqrt", Function::Sqrt, 1 }, { "abs", Function::Abs, 1 }, { "exp", Function::Exp, 1 },
+    { "log", Function::Log, 1 }, { "sin", Function::Sin, 1 }, { "cos", Function::Cos, 1 },
+    { "min", Function::Min, 2 }, { "max", Function::Max, 2 }, { "pow", Function::Pow, 2 },
+};
+
+inline const FunctionInfo& functionInfo(Function function) {
+    return functionTable[static_cast<std::size_t>(function)];
+}
+
+struct Node {
+    NodeKind kind;
+    Function function = Function::Sqrt; // Call only
+    std::uint32_t left = 0;             // first operand; for Variable, the index into Expression::variables
+    std::uint32_t right = 0;            // second operand of binary operators and two-argument calls
+    double value = 0;                   // Number only
+};
+
+struct Expression {
+    std::vector<Node> nodes;            // every node after its operands, the root last
+    std::vector<std::string> variables; // in order of first appearance
+
+    std::uint32_t root() const { return static_cast<std::uint32_t>(nodes.size() - 1); }
+};
+
+inline bool isUnary(NodeKind kind) {
+    return kind == NodeKind::Negate;
+}
+
+inline bool isBinary(NodeKind kind) {
+    return kind >= NodeKind::Add && kind <= NodeKind::Power;
+}
+
+// Operands a and b are the values of node.left and node.right. Throws the same "Division by zero"
+// error as evaluateRPN(); everything else follows IEEE arithmetic (sqrt(-1) is NaN).
+inline double applyNode(const Node& node, double a, double b) {
+    switch (node.kind) {
+    case NodeKind::Negate: return -a;
+    case NodeKind::Add: return a + b;
+    case NodeKind::Subtract: return a - b;
+    case NodeKind::Multiply: return a * b;
+    case NodeKind::Divide:
+        if (b == 0) throw std::runtime_error("Error: Division by zero.");
+        return a / b;
+    case NodeKind::Power: return std::pow(a, b);
+    case NodeKind::Call:
+        switch (node.function) {
+        case Function::Sqrt: return std::sqrt(a);
+        case Function::Abs: return std::fabs(a);
+        case Function::Exp: return std::exp(a);
+        case Function::Log: return std::log(a);
+        case Function::Sin: return std::sin(a);
+        case Function::Cos: return std::cos(a);
+        case Function::Min: return std::fmin(a, b);
+        case Function::Max: return std::fmax(a, b);
+        case Function::Pow: return std::pow(a, b);
+        }
+        break;
+    case NodeKind::Number:
+    case NodeKind::Variable:
+        break;
+    }
+    return node.value;
+}
+
+namespace detail
+{
+    class ExpressionParser {
+    public:
+        explicit ExpressionParser(std::string_view text) : text(text) {}
+
+        Expression parse() {
+            expression.nodes.reserve(text.size() / 2 + 1);
+            bool expectOperand = true;
+            while (skipSpace() < text.size()) {
+                std::size_t start = pos;
+                char ch = text[pos];
+                if (std::isdigit(static_cast<unsigned char>(ch)) || ch == '.') {
+                    if (!expectOperand) fail("Expected an operator", start);
+                    pushNumber();
+                    expectOperand = false;
+                }
+                else if (std::isalpha(static_cast<unsigned char>(ch)) || ch == '_') {
+                    if (!expectOperand) fail("Expected an operator", start);
+                    std::string_view name = identifier();
+                    if (skipSpace() < text.size() && text[pos] == '(') {
+                        pos++;
+                        operators.push_back({ Pending::Call, NodeKind::Call, lookupFunction(name, start), 1, start });
+                    }
+                    else {
+                        pushVariable(name);
+                        expectOperand = false;
+                    }
+                }
+                else if (ch == '(') {
+                    if (!expectOperand) fail("Expected an operator", start);
+                    pos++;
+                    operators.push_back({ Pending::Paren, NodeKind::Call, Function::Sqrt, 0, start });
+                }
+                else if (ch == ')' || ch == ',') {
+                    if (expectOperand) fail("Expected an operand", start);
+                    pos++;
+                    while (!operators.empty() && operators.back().kind == Pending::Operator) reduce();
+                    if (operators.empty()) fail(ch == ')' ? "Mismatched parentheses" : "Unexpected ','", start);
+                    Pending& open = operators.back();
+                    if (ch == ',') {
+                        if (open.kind != Pending::Call) fail("Unexpected ','", start);
+                        open.arguments++;
+                        expectOperand = true;
+                        continue;
+                    }
+                    if (open.kind == Pending::Call) {
+                        const FunctionInfo& info = functionInfo(open.function);
+                        if (open.arguments != info.arity) {
+                            fail(std::string(info.name) + " takes " + std::to_string(info.arity) + " argument(s)", open.position);
+                        }
+                        Node node{ NodeKind::Call, open.function };
+                        if (info.arity == 2) node.right = popOperand();
+                        node.left = popOperand();
+                        pushNode(node);
+                    }
+                    operators.pop_back();
+                }
+                else if (ch == '+' || ch == '-' || ch == '*' || ch == '/' || ch == '^') {
+                    pos++;
+                    if (expectOperand) {
+                        if (ch == '-') operators.push_back({ Pending::Operator, NodeKind::Negate, Function::Sqrt, 0, start });
+                        else if (ch != '+') fail("Expected an operand", start);
+                        continue;
+                    }
+                    NodeKind kind = binaryKind(ch);
+                    int rank = rankOf(kind);
+                    // ^ is right-associative: an equal-ranked ^ on the stack waits for its right operand.
+                    while (!operators.empty() && operators.back().kind == Pending::Operator) {
+                        int top = rankOf(operators.back().op);
+                        if (top < rank || (top == rank && kind == NodeKind::Power)) break;
+                        reduce();
+                    }
+                    operators.push_back({ Pending::Operator, kind, Function::Sqrt, 0, start });
+                    expectOperand = true;
+                }
+                else {
+                    fail(std::string("Invalid character '") + ch + "'", start);
+                }
+            }
+            if (expectOperand) fail("Expected an operand", text.size());
+            while (!operators.empty()) {
+                if (operators.back().kind != Pending::Operator) fail("Mismatched parentheses", operators.back().position);
+                reduce();
+            }
+            return std::move(expression);
+        }
+
+    private:
+        struct Pending {
+            enum Kind : std::uint8_t { Operator, Paren, Call } kind;
+            NodeKind op;
+            Function function;
+            unsigned arguments; // Call: commas seen so far + 1
+            std::size_t position;
+        };
+
+        std::string_view text;
+        std::size_t pos = 0;
+        Expression expression;
+        std::vector<std::uint32_t> operands;
+        std::vector<Pending> operators;
+        std::unordered_map<std::string_view, std::uint32_t> variableIndex;
+
+        [[noreturn]] static void fail(const std::string& what, std::size_t position) {
+            throw std::runtime_error("Error: " + what + " at position " + std::to_string(position) + ".");
+        }
+
+        std::size_t skipSpace() {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+            return pos;
+        }
+
+        static NodeKind binaryKind(char ch) {
+            switch (ch) {
+            case '+': return NodeKind::Add;
+            case '-': return NodeKind::Subtract;
+            case '*': return NodeKind::Multiply;
+            case '/': return NodeKind::Divide;
+            default: return NodeKind::Power;
+            }
+        }
+
+        // Binding strength; + - and * / match precedence().
+        static int rankOf(NodeKind kind) {
+            switch (kind) {
+            case NodeKind::Add: case NodeKind::Subtract: return 1;
+            case NodeKind::Multiply: case NodeKind::Divide: return 2;
+            case NodeKind::Negate: return 3;
+            default: return 4;
+            }
+        }
+
+        std::string_view identifier() {
+            std::size_t start = pos;
+            while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_')) pos++;
+            return text.substr(start, pos - start);
+        }
+
+        static Function lookupFunction(std::string_view name, std::size_t position) {
+            for (const FunctionInfo& info : functionTable) {
+                if (info.name == name) return info.function;
+            }
+            fail("Unknown function '" + std::string(name) + "'", position);
+        }
+
+        void pushNumber() {
+            std::size_t start = pos;
+            while (pos < text.size() && (std::isdigit(static_cast<unsigned char>(text[pos])) || text[pos] == '.')) pos++;
+            if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+                std::size_t exponent = pos + 1;
+                if (exponent < text.size() && (text[exponent] == '+' || text[exponent] == '-')) exponent++;
+                if (exponent < text.size() && std::isdigit(static_cast<unsigned char>(text[exponent]))) {
+                    pos = exponent;
+                    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) pos++;
+                }
+            }
+            Node node{ NodeKind::Number };
+            auto [end, error] = std::from_chars(text.data() + start, text.data() + pos, node.value);
+            if (error != std::errc() || end != text.data() + pos) fail("Invalid number", start);
+            pushNode(node);
+        }
+
+        void pushVariable(std::string_view name) {
+            auto [it, added] = variableIndex.emplace(name, static_cast<std::uint32_t>(expression.variables.size()));
+            if (added) expression.variables.emplace_back(name);
+            pushNode(Node{ NodeKind::Variable, Function::Sqrt, it->second });
+        }
+
+        void pushNode(const Node& node) {
+            operands.push_back(static_cast<std::uint32_t>(expression.nodes.size()));
+            expression.nodes.push_back(node);
+        }
+
+        std::uint32_t popOperand() {
+            std::uint32_t index = operands.back();
+            operands.pop_back();
+            return index;
+        }
+
+        // Applies the operator on top of the stack to the operands on top of theirs.
+        void reduce() {
+            Node node{ operators.back().op };
+            operators.pop_back();
+            if (isBinary(node.kind)) node.right = popOperand();
+            node.left = popOperand();
+            pushNode(node);
+        }
+    };
+} // namespace detail
+
+// Throws std::runtime_error("Error: ... at position N.") for text that is not an expression.
+inline Expression parseExpression(std::string_view text) {
+    return detail::ExpressionParser(text).parse();
+}
+
+// variables[i] is the value of expression.variables[i]; scratch must hold expression.nodes.size() values.
+inline double evaluate(const Expression& expression, const double* variables, double* scratch) {
+    for (std::size_t i = 0; i < expression.nodes.size(); i++) {
+        const Node& node = expression.nodes[i];
+        if (node.kind == NodeKind::Number) scratch[i] = node.value;
+        else if (node.kind == NodeKind::Variable) scratch[i] = variables[node.left];
+        else scratch[i] = applyNode(node, scratch[node.left], scratch[node.right]);
+    }
+    return scratch[expression.root()];
+}
+
+inline double evaluate(const Expression& expression, const std::vector<double>& variables) {
+    std::vector<double> scratch(expression.nodes.size());
+    return evaluate(expression, variables.data(), scratch.data());
+}
+
+// The expression in postfix form, e.g. "x 2 ^ neg 3 +", for display.
+inline std::string toRPN(const Expression& expression) {
+    std::ostringstream out;
+    for (const Node& node : expression.nodes) {
+        switch (node.kind) {
+        case NodeKind::Number: out << node.value; break;
+        case NodeKind::Variable: out << expression.variables[node.left]; break;
+        case NodeKind::Negate: out << "neg"; break;
+        case NodeKind::Add: out << '+'; break;
+        case NodeKind::Subtract: out << '-'; break;
+        case NodeKind::Multiply: out << '*'; break;
+        case NodeKind::Divide: out << '/'; break;
+        case NodeKind::Power: out << '^'; break;
+        case NodeKind::Call: out << functionInfo(node.function).name; break;
+        }
+        out << ' ';
+    }
+    return out.str();
+}
+
+#endif // PARSER_H
@@ -0,0 +1,211 @@
+#ifndef RPN_H
+#define RPN_H
+
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+constexpr int precedence(char op) {
+    if (op == '+' || op == '-') return 1;
+    if (op == '*' || op == '/') return 2;
+    return 0;
+}
+
+inline bool isValidExpression(const std::string& expression) {
+    int balance = 0;
+    for (char ch : expression) {
+        if (!(std::isalpha(ch) || std::isspace(ch) || ch == '+' || ch == '-' || ch == '*' || ch == '/' || ch == '(' || ch == ')')) {
+            std::cout << "Error: Invalid character '" << ch << "' in expression.\n";
+            return false;
+        }
+        if (ch == '(') balance++;
+        if (ch == ')') balance--;
+        if (balance < 0) {
+            std::cout << "Error: Mismatched parentheses.\n";
+            return false;
+        }
+    }
+    if (balance != 0) {
+        std::cout << "Error: Mismatched parentheses.\n";
+        return false;
+    }
+    return true;
+}
+
+inline std::string infixToRPN(const std::string& expression) {
+    std::stack<char> operators;
+    std::stringstream output;
+    for (size_t i = 0; i < expression.size(); ++i) {
+        char ch = expression[i];
+        if (std::isspace(ch)) continue;
+        if (std::isalpha(ch)) {
+            output << ch << ' ';
+        }
+        else if (ch == '(') {
+            operators.push(ch);
+        }
+        else if (ch == ')') {
+            while (!operators.empty() && operators.top() != '(') {
+                output << operators.top() << ' ';
+                operators.pop();
+            }
+            operators.pop();
+        }
+        else {
+            while (!operators.empty() && precedence(operators.top()) >= precedence(ch)) {
+                output << operators.top() << ' ';
+                operators.pop();
+            }
+            operators.push(ch);
+        }
+    }
+    while (!operators.empty()) {
+        output << operators.top() << ' ';
+        operators.pop();
+    }
+    return output.str();
+}
+
+// A stack that keeps its first N items in place and only goes to the heap beyond that.
+template <typename T, std::size_t N>
+class SmallStack {
+public:
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    void push(T item) {
+        if (count < N) {
+            items[count] = item;
+        }
+        else {
+            if (spill.empty()) spill.reserve(N);
+            spill.push_back(item);
+        }
+        count++;
+    }
+
+    T top() const { return count <= N ? items[count - 1] : spill.back(); }
+
+    void pop() {
+        if (count > N) spill.pop_back();
+        count--;
+    }
+
+private:
+    T items[N];
+    std::vector<T> spill;
+    std::size_t count = 0;
+};
+
+namespace detail
+{
+    enum class CharClass : unsigned char { Operator, Space, Letter, Open, Close };
+
+    // isspace() and isalpha() of the "C" locale, looked up without going through the locale.
+    constexpr auto charClasses = [] {
+        std::array<CharClass, 256> table{};
+        for (unsigned char ch : { ' ', '\t', '\n', '\v', '\f', '\r' }) table[ch] = CharClass::Space;
+        for (int ch = 'a'; ch <= 'z'; ch++) table[ch] = table[ch - 'a' + 'A'] = CharClass::Letter;
+        table['('] = CharClass::Open;
+        table[')'] = CharClass::Close;
+        return table;
+    }();
+} // namespace detail
+
+// Same conversion and the same text as infixToRPN(), written to out[0, capacity) instead of a new string.
+// Returns the length of the whole text even if only part of it fitted, so a result greater than capacity
+// means the buffer was too small; 2 * expression.size() is always enough. Up to MaxDepth pending
+// operators and parentheses are kept on the machine stack, so a call allocates nothing unless the
+// expression nests deeper than that. A ')' without a matching '(' is ignored.
+template <std::size_t MaxDepth = 64>
+std::size_t infixToRPN(std::string_view expression, char* out, std::size_t capacity) {
+    SmallStack<char, MaxDepth> operators;
+    std::size_t length = 0;
+    auto emit = [&](char token) {
+        if (length + 2 <= capacity) {
+            out[length] = token;
+            out[length + 1] = ' ';
+        }
+        length += 2;
+    };
+    for (char ch : expression) {
+        switch (detail::charClasses[static_cast<unsigned char>(ch)]) {
+        case detail::CharClass::Space:
+            break;
+        case detail::CharClass::Letter:
+            emit(ch);
+            break;
+        case detail::CharClass::Open:
+            operators.push(ch);
+            break;
+        case detail::CharClass::Close:
+            while (!operators.empty() && operators.top() != '(') {
+                emit(operators.top());
+                operators.pop();
+            }
+            if (!operators.empty()) operators.pop();
+            break;
+        case detail::CharClass::Operator:
+            while (!operators.empty() && precedence(operators.top()) >= precedence(ch)) {
+                emit(operators.top());
+                operators.pop();
+            }
+            operators.push(ch);
+            break;
+        }
+    }
+    while (!operators.empty()) {
+        emit(operators.top());
+        operators.pop();
+    }
+    return length;
+}
+
+// Into a reused string: allocates only when out has never held an expression this long.
+template <std::size_t MaxDepth = 64>
+void infixToRPN(std::string_view expression, std::string& out) {
+    out.resize(2 * expression.size());
+    out.resize(infixToRPN<MaxDepth>(expression, out.data(), out.size()));
+}
+
+inline double evaluateRPN(const std::string& rpn, const std::unordered_map<char, double>& values) {
+    std::stack<double> operands;
+    std::stringstream tokens(rpn);
+    std::string token;
+    while (tokens >> token) {
+        if (std::isalpha(token[0])) {
+            operands.push(values.at(token[0]));
+        }
+        else {
+            if (operands.size() < 2) {
+                throw std::runtime_error("Error: Malformed expression.");
+            }
+            double b = operands.top(); operands.pop();
+            double a = operands.top(); operands.pop();
+            switch (token[0]) {
+            case '+': operands.push(a + b); break;
+            case '-': operands.push(a - b); break;
+            case '*': operands.push(a * b); break;
+            case '/':
+                if (b == 0) throw std::runtime_error("Error: Division by zero.");
+                operands.push(a / b);
+                break;
+            default: throw std::runtime_error("Error: Unknown operator.");
+            }
+        }
+    }
+    if (operands.size() != 1) {
+        throw std::runtime_error("Error: Malformed expression.");
+    }
+    return operands.top();
+}
+
+#endif // RPN_H
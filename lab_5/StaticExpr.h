@@ -0,0 +1,164 @@
+#ifndef STATIC_EXPR_H
+#define STATIC_EXPR_H
+
+#include "Bytecode.h"
+#include "RPN.h"
+
+#include <cstddef>
+#include <stdexcept>
+
+// Formulas fixed at build time, parsed by the compiler.
+//
+//     double r = evaluateStatic<"(a+b)*c/d">(values);
+//
+// The string literal is a template argument. A constexpr copy of infixToRPN() -- same grammar, same
+// precedence() -- turns it into RPN during compilation, and the RPN is rebuilt into a tree of types
+// (Variable<slot>, Operation<op, Left, Right>) whose static eval() functions the optimizer inlines into
+// straight-line arithmetic: no instructions to dispatch and no stack. A malformed formula is a compile
+// error. Division by zero throws the same std::runtime_error as evaluateRPN().
+
+template <std::size_t N>
+struct FixedString {
+    char text[N];
+
+    constexpr FixedString(const char (&literal)[N]) {
+        for (std::size_t i = 0; i < N; i++) text[i] = literal[i];
+    }
+};
+
+namespace detail
+{
+    constexpr bool isVariable(char ch) {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+    }
+
+    constexpr bool isOperator(char ch) {
+        return ch == '+' || ch == '-' || ch == '*' || ch == '/';
+    }
+
+    // RPN as one character per token. `valid` is false for input that isValidExpression() would reject
+    // or that does not form a single expression.
+    template <std::size_t N>
+    struct StaticRPN {
+        char tokens[N] = {};
+        std::size_t size = 0;
+        bool valid = true;
+    };
+
+    template <std::size_t N>
+    constexpr StaticRPN<N> toStaticRPN(const FixedString<N>& expression) {
+        StaticRPN<N> rpn;
+        char operators[N] = {};
+        std::size_t depth = 0;
+        for (std::size_t i = 0; i + 1 < N; i++) {
+            char ch = expression.text[i];
+            if (ch == ' ' || ch == '\t') continue;
+            if (isVariable(ch)) {
+                rpn.tokens[rpn.size++] = ch;
+            }
+            else if (ch == '(') {
+                operators[depth++] = ch;
+            }
+            else if (ch == ')') {
+                while (depth && operators[depth - 1] != '(') rpn.tokens[rpn.size++] = operators[--depth];
+                if (!depth) {
+                    rpn.valid = false;
+                    return rpn;
+                }
+                depth--;
+            }
+            else if (isOperator(ch)) {
+                while (depth && precedence(operators[depth - 1]) >= precedence(ch)) rpn.tokens[rpn.size++] = operators[--depth];
+                operators[depth++] = ch;
+            }
+            else {
+                rpn.valid = false;
+                return rpn;
+            }
+        }
+        while (depth) {
+            char op = operators[--depth];
+            if (op == '(') rpn.valid = false;
+            rpn.tokens[rpn.size++] = op;
+        }
+
+        // The same operand count check evaluateRPN() makes while it runs.
+        std::size_t operands = 0;
+        for (std::size_t i = 0; i < rpn.size && rpn.valid; i++) {
+            if (isVariable(rpn.tokens[i])) operands++;
+            else if (operands < 2) rpn.valid = false;
+            else operands--;
+        }
+        if (operands != 1) rpn.valid = false;
+        return rpn;
+    }
+
+    // Index of the first token of the subexpression that ends at `last`.
+    template <std::size_t N>
+    constexpr std::size_t subexpressionStart(const StaticRPN<N>& rpn, std::size_t last) {
+        std::size_t needed = 1;
+        std::size_t i = last + 1;
+        while (needed) {
+            --i;
+            if (isVariable(rpn.tokens[i])) needed--;
+            else needed++;
+        }
+        return i;
+    }
+} // namespace detail
+
+template <std::size_t Slot>
+struct Variable {
+    static double eval(const Bindings& values) { return values[Slot]; }
+};
+
+template <char Op, typename Left, typename Right>
+struct Operation {
+    static double eval(const Bindings& values) {
+        double a = Left::eval(values);
+        double b = Right::eval(values);
+        if constexpr (Op == '+') return a + b;
+        else if constexpr (Op == '-') return a - b;
+        else if constexpr (Op == '*') return a * b;
+        else {
+            if (b == 0) throw std::runtime_error("Error: Division by zero.");
+            return a / b;
+        }
+    }
+};
+
+namespace detail
+{
+    template <auto RPN, std::size_t Last>
+    constexpr auto expressionNode() {
+        constexpr char token = RPN.tokens[Last];
+        if constexpr (isVariable(token)) {
+            return Variable<variableSlot(token)>{};
+        }
+        else {
+            constexpr std::size_t rightStart = subexpressionStart(RPN, Last - 1);
+            using Left = decltype(expressionNode<RPN, rightStart - 1>());
+            using Right = decltype(expressionNode<RPN, Last - 1>());
+            return Operation<token, Left, Right>{};
+        }
+    }
+
+    template <FixedString Expression>
+    constexpr auto expressionType() {
+        constexpr auto rpn = toStaticRPN(Expression);
+        static_assert(rpn.valid, "evaluateStatic: malformed expression");
+        if constexpr (rpn.valid) return expressionNode<rpn, rpn.size - 1>();
+        else return Variable<0>{};
+    }
+} // namespace detail
+
+// The expression's type: its eval(const Bindings&) computes the formula.
+template <FixedString Expression>
+using StaticExpression = decltype(detail::expressionType<Expression>());
+
+template <FixedString Expression>
+double evaluateStatic(const Bindings& values) {
+    return StaticExpression<Expression>::eval(values);
+}
+
+#endif // STATIC_EXPR_H
@@ -0,0 +1,92 @@
+#include "../BatchEval.h"
+#include "../Bytecode.h"
+#include "../RPN.h"
+#include "BenchUtils.h"
+#include <cmath>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Formulas scored over columns of values: evaluateRPN() called row by row, the compiled program row by
+// row, and evaluateBatch() over the columns. About one row in a hundred divides by zero.
+// Usage: Lab5BatchBench [rows]
+int main(int argc, char** argv)
+{
+    std::size_t rows = bench::argOr(argc, argv, 1, 1'000'000);
+    const std::vector<std::string> formulas = {
+        "(a+b)*c/d",
+        "a*b+c*d-e",
+        "(a-b)*(c+d)/(e+a)-b*c+d/e",
+        "((a+b)*(c-d)+(e*a-b)/(c+d*e))*(a-b/c)+d*(e-a)/(b+c)",
+    };
+    const char variables[] = { 'a', 'b', 'c', 'd', 'e' };
+
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<double> valueDist(-100.0, 100.0);
+    std::uniform_int_distribution<int> zeroDist(0, 99);
+    std::vector<std::vector<double>> data(std::size(variables), std::vector<double>(rows));
+    for (auto& column : data) {
+        for (double& value : column) value = zeroDist(gen) == 0 ? 0.0 : valueDist(gen);
+    }
+    Columns columns{};
+    for (std::size_t v = 0; v < std::size(variables); ++v) columns[variableSlot(variables[v])] = data[v].data();
+
+#if defined(BATCH_EVAL_AVX2)
+    std::cout << "rows: " << rows << ", AVX2 kernels" << std::endl;
+#else
+    std::cout << "rows: " << rows << ", scalar kernels" << std::endl;
+#endif
+    std::vector<double> expected(rows), out(rows);
+    std::vector<std::uint8_t> expectedZero(rows), zero(rows);
+    for (const std::string& formula : formulas) {
+        std::string rpn = infixToRPN(formula);
+        Program program = compileRPN(rpn);
+        std::cout << formula << std::endl;
+
+        std::unordered_map<char, double> values;
+        double tString = bench::measure([&] {
+            for (std::size_t i = 0; i < rows; ++i) {
+                for (std::size_t v = 0; v < std::size(variables); ++v) values[variables[v]] = data[v][i];
+                try {
+                    expected[i] = evaluateRPN(rpn, values);
+                    expectedZero[i] = 0;
+                }
+                catch (const std::runtime_error&) {
+                    expected[i] = std::nan("");
+                    expectedZero[i] = 1;
+                }
+            }
+        });
+        double sum = 0;
+        double tProgram = bench::measure([&] {
+            Bindings row{};
+            for (std::size_t i = 0; i < rows; ++i) {
+                for (std::size_t v = 0; v < std::size(variables); ++v) row[variableSlot(variables[v])] = data[v][i];
+                try {
+                    sum += evaluate(program, row);
+                }
+                catch (const std::runtime_error&) {
+                }
+            }
+        });
+        double tBatch = bench::measure([&] { evaluateBatch(program, columns, rows, out.data(), zero.data()); });
+        bench::doNotOptimize(sum);
+
+        bench::report("  evaluateRPN per row", tString, rows);
+        bench::report("  compiled program per row", tProgram, rows);
+        bench::report("  evaluateBatch", tBatch, rows);
+
+        std::size_t flagged = 0;
+        for (std::size_t i = 0; i < rows; ++i) {
+            bool same = zero[i] == expectedZero[i] && (zero[i] ? std::isnan(out[i]) : out[i] == expected[i]);
+            if (!same) {
+                std::cerr << "row " << i << " differs: " << out[i] << " vs " << expected[i] << std::endl;
+                return 1;
+            }
+            flagged += zero[i];
+        }
+        std::cout << "  rows with division by zero: " << flagged << std::endl;
+    }
+    return 0;
+}
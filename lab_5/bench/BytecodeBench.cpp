@@ -0,0 +1,57 @@
+#include "../Bytecode.h"
+#include "../RPN.h"
+#include "BenchUtils.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The same formulas evaluated over many different bindings: evaluateRPN() on the RPN string with an
+// unordered_map of values, against a program compiled once by compileRPN().
+// Usage: Lab5BytecodeBench [evaluations]
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    const std::vector<std::string> formulas = {
+        "(a+b)*c/d",
+        "a*b+c*d-e",
+        "(a-b)*(c+d)/(e+a)-b*c+d/e",
+        "((a+b)*(c-d)+(e*a-b)/(c+d*e))*(a-b/c)+d*(e-a)/(b+c)",
+    };
+
+    // Divisors stay away from zero so that no evaluation throws.
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> valueDist(1.0, 100.0);
+    std::vector<Bindings> rows(1024);
+    for (auto& row : rows) {
+        for (char var : { 'a', 'b', 'c', 'd', 'e' }) row[variableSlot(var)] = valueDist(gen);
+    }
+
+    std::cout << "evaluations per formula: " << n << std::endl;
+    for (const std::string& formula : formulas) {
+        std::string rpn = infixToRPN(formula);
+        Program program = compileRPN(rpn);
+        std::cout << formula << "  (" << program.code.size() << " instructions)" << std::endl;
+
+        std::unordered_map<char, double> values;
+        double sumString = 0, sumProgram = 0;
+        double tString = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                const Bindings& row = rows[i % rows.size()];
+                for (char var : { 'a', 'b', 'c', 'd', 'e' }) values[var] = row[variableSlot(var)];
+                sumString += evaluateRPN(rpn, values);
+            }
+        });
+        double tProgram = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) sumProgram += evaluate(program, rows[i % rows.size()]);
+        });
+        bench::report("  evaluateRPN", tString, n);
+        bench::report("  compiled program", tProgram, n);
+        std::cout << "  speedup " << std::fixed << std::setprecision(1) << tString / tProgram << "x" << std::endl;
+        if (sumString != sumProgram) {
+            std::cerr << "results differ: " << sumString << " vs " << sumProgram << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
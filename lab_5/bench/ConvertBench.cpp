@@ -0,0 +1,96 @@
+#include "../RPN.h"
+#include "BenchUtils.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// Heap allocations and time per call of infixToRPN(): the string-returning version against the one
+// writing into a caller's buffer, and into a reused std::string. Allocations are counted by replacing
+// the global operator new. The last formula nests deeper than the default 64 pending operators, so the
+// buffer version has to spill its operator stack to the heap there.
+// Usage: Lab5ConvertBench [calls per formula]
+namespace
+{
+    std::size_t allocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 200'000);
+    std::string deep;
+    for (int i = 0; i < 100; ++i) deep += "(a+";
+    deep += "b";
+    for (int i = 0; i < 100; ++i) deep += ")";
+    std::string wide = "a*b";
+    for (int i = 0; i < 60; ++i) wide += i % 2 ? "+c*d" : "-(e/a+b)";
+    const std::vector<std::string> formulas = {
+        "(a+b)*c/d",
+        "((a+b)*(c-d)+(e*a-b)/(c+d*e))*(a-b/c)+d*(e-a)/(b+c)",
+        wide,
+        deep,
+    };
+
+    std::cout << "calls per formula: " << n << std::endl;
+    for (const std::string& formula : formulas) {
+        std::cout << (formula.size() > 60 ? formula.substr(0, 57) + "..." : formula) << "  (" << formula.size() << " chars)" << std::endl;
+        std::string expected = infixToRPN(formula);
+
+        std::size_t before = allocations;
+        double tString = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) bench::doNotOptimize(infixToRPN(formula));
+        });
+        std::size_t stringAllocations = allocations - before;
+
+        std::vector<char> buffer(2 * formula.size());
+        std::size_t length = 0;
+        before = allocations;
+        double tBuffer = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                length = infixToRPN(formula, buffer.data(), buffer.size());
+                bench::doNotOptimize(buffer);
+            }
+        });
+        std::size_t bufferAllocations = allocations - before;
+
+        std::string reused;
+        before = allocations;
+        double tReused = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                infixToRPN(formula, reused);
+                bench::doNotOptimize(reused);
+            }
+        });
+        std::size_t reusedAllocations = allocations - before;
+
+        bench::report("  infixToRPN -> std::string", tString, n);
+        bench::report("  infixToRPN -> caller buffer", tBuffer, n);
+        bench::report("  infixToRPN -> reused string", tReused, n);
+        std::cout << "  allocations per call: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(stringAllocations) / n << " / "
+                  << static_cast<double>(bufferAllocations) / n << " / "
+                  << static_cast<double>(reusedAllocations) / n << std::endl;
+        if (std::string(buffer.data(), length) != expected || reused != expected) {
+            std::cerr << "results differ" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include "../Incremental.h"
+#include "../Parser.h"
+#include "../RPN.h"
+#include "BenchUtils.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Update latency when one of the variables a..e changes between evaluations: evaluateRPN() on the whole
+// expression, evaluate() on all parsed nodes, and IncrementalEvaluator recomputing only what depends on
+// the changed variable. The other letters f..z are fixed parameters. Two shapes: a random tree, and a
+// left-deep chain as deep as it is long, where a change near the bottom dirties everything above it.
+// Usage: Lab5IncrementalBench [leaves] [updates]
+namespace
+{
+    char leaf(std::mt19937& gen)
+    {
+        // About one leaf in eight is one of the changing variables.
+        if (gen() % 8 == 0) return static_cast<char>('a' + gen() % 5);
+        return static_cast<char>('f' + gen() % 21);
+    }
+
+    // Values are drawn from [0.5, 2], and only a single letter is ever multiplied by or divided by, so
+    // even a chain thousands deep neither overflows nor divides by zero.
+    char op(bool rightIsLeaf, std::mt19937& gen)
+    {
+        const char ops[] = { '+', '-', '*', '/' };
+        return ops[gen() % (rightIsLeaf ? 4 : 2)];
+    }
+
+    void randomTree(std::size_t leaves, std::mt19937& gen, std::string& out)
+    {
+        if (leaves == 1) {
+            out += leaf(gen);
+            return;
+        }
+        std::size_t left = 1 + gen() % (leaves - 1);
+        out += '(';
+        randomTree(left, gen, out);
+        out += op(leaves - left == 1, gen);
+        randomTree(leaves - left, gen, out);
+        out += ')';
+    }
+
+    std::string chain(std::size_t leaves, std::mt19937& gen)
+    {
+        std::string out(leaves - 1, '(');
+        out += leaf(gen);
+        for (std::size_t i = 1; i < leaves; ++i) {
+            out += op(true, gen);
+            out += leaf(gen);
+            out += ')';
+        }
+        return out;
+    }
+
+    int run(const std::string& name, const std::string& infix, std::size_t updates, std::mt19937& gen)
+    {
+        std::uniform_real_distribution<double> valueDist(0.5, 2.0);
+        std::string rpn = infixToRPN(infix);
+        Expression expression = parseExpression(infix);
+
+        std::unordered_map<char, double> map;
+        std::vector<double> values;
+        for (const std::string& variable : expression.variables) {
+            double value = valueDist(gen);
+            map[variable[0]] = value;
+            values.push_back(value);
+        }
+        std::vector<std::size_t> changing; // indices of a..e in expression.variables
+        for (std::size_t i = 0; i < expression.variables.size(); ++i) {
+            if (expression.variables[i][0] <= 'e') changing.push_back(i);
+        }
+        struct Update {
+            std::size_t variable;
+            double value;
+        };
+        std::vector<Update> sequence(updates);
+        for (Update& update : sequence) update = { changing[gen() % changing.size()], valueDist(gen) };
+
+        IncrementalEvaluator incremental(expression, values);
+        std::size_t recomputed = 0;
+        std::vector<double> byRPN(updates), byNodes(updates), byIncremental(updates), scratch(expression.nodes.size());
+        incremental.value();
+
+        double tRPN = bench::measure([&] {
+            for (std::size_t i = 0; i < updates; ++i) {
+                map[expression.variables[sequence[i].variable][0]] = sequence[i].value;
+                byRPN[i] = evaluateRPN(rpn, map);
+            }
+        });
+        double tNodes = bench::measure([&] {
+            for (std::size_t i = 0; i < updates; ++i) {
+                values[sequence[i].variable] = sequence[i].value;
+                byNodes[i] = evaluate(expression, values.data(), scratch.data());
+            }
+        });
+        double tIncremental = bench::measure([&] {
+            for (std::size_t i = 0; i < updates; ++i) {
+                incremental.set(sequence[i].variable, sequence[i].value);
+                byIncremental[i] = incremental.value();
+                recomputed += incremental.recomputed();
+            }
+        });
+
+        std::cout << name << ": " << expression.nodes.size() << " nodes, "
+                  << std::fixed << std::setprecision(1) << static_cast<double>(recomputed) / updates
+                  << " recomputed per update on average" << std::endl;
+        bench::report("  evaluateRPN (whole expression)", tRPN, updates);
+        bench::report("  evaluate (all nodes)", tNodes, updates);
+        bench::report("  IncrementalEvaluator", tIncremental, updates);
+        std::cout << "  speedup over evaluateRPN " << std::setprecision(1) << tRPN / tIncremental
+                  << "x, over evaluate " << tNodes / tIncremental << "x" << std::endl;
+
+        for (std::size_t i = 0; i < updates; ++i) {
+            if (byRPN[i] != byIncremental[i] || byNodes[i] != byIncremental[i]) {
+                std::cerr << "update " << i << ": results differ" << std::endl;
+                return 1;
+            }
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t leaves = bench::argOr(argc, argv, 1, 4000);
+    std::size_t updates = bench::argOr(argc, argv, 2, 5000);
+    std::mt19937 gen(46);
+
+    std::string tree;
+    randomTree(leaves, gen, tree);
+    int failed = run("random tree", tree, updates, gen);
+    failed |= run("left-deep chain", chain(leaves, gen), updates, gen);
+    return failed;
+}
@@ -0,0 +1,96 @@
+#include "../Optimizer.h"
+#include "../Parser.h"
+#include "BenchUtils.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// A corpus of generated formulas in the style of a rule engine -- subterms reused over and over,
+// constant factors, "* 1" and "+ 0" from templates with default parameters -- evaluated as parsed and
+// after optimize().
+// Usage: Lab5OptimizeBench [formulas] [evaluations per formula]
+namespace
+{
+    std::string generateFormula(std::mt19937& gen)
+    {
+        std::vector<std::string> pool = { "a", "b", "c", "d", "e", "2", "0.5", "(3*4-2)", "(1/8+0.25)" };
+        const char* ops[] = { " + ", " - ", " * ", " / " };
+        std::size_t steps = 8 + gen() % 16;
+        for (std::size_t i = 0; i < steps; ++i) {
+            const std::string& x = pool[gen() % pool.size()];
+            const std::string& y = pool[gen() % pool.size()];
+            std::string term;
+            switch (gen() % 8) {
+            case 0: term = "(" + x + " * 1)"; break;
+            case 1: term = "(" + x + " + 0)"; break;
+            case 2: term = "sqrt(" + x + " * " + x + " + 1)"; break;
+            case 3: term = "max(" + x + ", " + y + ")"; break;
+            default: term = "(" + x + ops[gen() % 4] + y + ")"; break;
+            }
+            pool.push_back(term);
+        }
+        // The formula combines the last few terms, each of which repeats parts of the others.
+        std::string formula = pool.back();
+        for (std::size_t i = 2; i <= 4; ++i) formula += std::string(ops[gen() % 3]) + pool[pool.size() - i];
+        return formula;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t formulas = bench::argOr(argc, argv, 1, 1000);
+    std::size_t evaluations = bench::argOr(argc, argv, 2, 2000);
+    std::mt19937 gen(6);
+
+    std::vector<Expression> parsed, optimized;
+    OptimizeStats total;
+    double optimizeSeconds = 0;
+    for (std::size_t f = 0; f < formulas; ++f) {
+        parsed.push_back(parseExpression(generateFormula(gen)));
+        OptimizeStats stats;
+        optimizeSeconds += bench::measure([&] { optimized.push_back(optimize(parsed.back(), &stats)); });
+        total.operationsBefore += stats.operationsBefore;
+        total.operationsAfter += stats.operationsAfter;
+        total.folded += stats.folded;
+        total.simplified += stats.simplified;
+        total.shared += stats.shared;
+    }
+
+    std::cout << "formulas: " << formulas << ", evaluations each: " << evaluations << std::endl
+              << "operations: " << total.operationsBefore << " -> " << total.operationsAfter << " ("
+              << std::fixed << std::setprecision(1) << 100.0 * (total.operationsBefore - total.operationsAfter) / total.operationsBefore
+              << "% removed: " << total.folded << " folded, " << total.simplified << " identities, "
+              << total.shared << " shared)" << std::endl;
+    bench::report("optimize", optimizeSeconds, formulas);
+
+    std::uniform_real_distribution<double> valueDist(1.0, 9.0);
+    std::vector<double> rows(5 * 1024), scratch;
+    for (double& value : rows) value = valueDist(gen);
+    auto run = [&](const std::vector<Expression>& corpus) {
+        double sum = 0;
+        double seconds = bench::measure([&] {
+            for (const Expression& expression : corpus) {
+                scratch.resize(expression.nodes.size());
+                for (std::size_t i = 0; i < evaluations; ++i) {
+                    try {
+                        sum += evaluate(expression, rows.data() + 5 * (i % 1024), scratch.data());
+                    }
+                    catch (const std::runtime_error&) {
+                        sum += 1e6; // a formula like x / (y - y) divides by zero in both forms
+                    }
+                }
+            }
+        });
+        return std::make_pair(seconds, sum);
+    };
+    auto [tParsed, sumParsed] = run(parsed);
+    auto [tOptimized, sumOptimized] = run(optimized);
+    bench::report("evaluate as parsed", tParsed, formulas * evaluations);
+    bench::report("evaluate optimized", tOptimized, formulas * evaluations);
+    std::cout << "speedup " << std::setprecision(2) << tParsed / tOptimized << "x" << std::endl;
+    if (std::abs(sumParsed - sumOptimized) > 1e-9 * std::abs(sumParsed)) {
+        std::cerr << "results differ: " << sumParsed << " vs " << sumOptimized << std::endl;
+        return 1;
+    }
+    return 0;
+}
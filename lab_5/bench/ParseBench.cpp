@@ -0,0 +1,91 @@
+#include "../Parser.h"
+#include "../RPN.h"
+#include "BenchUtils.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// parseExpression() on generated expressions of growing size -- time per token should stay flat --
+// and on shapes that would exhaust the call stack of a recursive parser: a million nested parentheses,
+// a million unary minuses and a right-associative chain of a million ^.
+// Usage: Lab5ParseBench [max tokens]
+namespace
+{
+    // Mixed expression: numbers, multi-letter variables, calls, unary minus and nested parentheses.
+    std::string generate(std::size_t tokens, std::mt19937& gen)
+    {
+        const char* names[] = { "a", "b", "speed", "time", "x1", "rate" };
+        const char ops[] = { '+', '-', '*', '/', '^' };
+        std::string text;
+        std::size_t depth = 0, count = 0;
+        while (count < tokens) {
+            switch (gen() % 6) {
+            case 0: text += "("; depth++; count++; break;
+            case 1: text += "-"; count++; break;
+            case 2: text += "min("; text += names[gen() % 6]; text += ", "; depth++; count += 4; break;
+            default: break;
+            }
+            if (gen() % 2) text += names[gen() % 6];
+            else text += std::to_string(gen() % 1000) + ".5";
+            count++;
+            while (depth && gen() % 3 == 0) {
+                text += ")";
+                depth--;
+                count++;
+            }
+            text += ' ';
+            text += ops[gen() % (gen() % 8 ? 4 : 5)];
+            text += ' ';
+            count++;
+        }
+        text += "1";
+        text.append(depth, ')');
+        return text;
+    }
+
+    // The old grammar: single letters and + - * / only.
+    std::string generateSimple(std::size_t tokens, std::mt19937& gen)
+    {
+        const char ops[] = { '+', '-', '*', '/' };
+        std::string text;
+        for (std::size_t i = 0; i + 2 < tokens; i += 2) {
+            text += static_cast<char>('a' + gen() % 5);
+            text += ops[gen() % 4];
+        }
+        return text + "a";
+    }
+
+    void parse(const std::string& name, const std::string& text, std::size_t tokens)
+    {
+        Expression expression;
+        double seconds = bench::measure([&] { expression = parseExpression(text); });
+        bench::report(name, seconds, tokens);
+        std::cout << std::setw(36) << "" << std::setprecision(1) << seconds * 1e9 / tokens << " ns per token, "
+                  << expression.nodes.size() << " nodes" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t maxTokens = bench::argOr(argc, argv, 1, 1'000'000);
+    std::mt19937 gen(4);
+
+    std::cout << "tokens per second:" << std::endl;
+    for (std::size_t tokens = 1000; tokens <= maxTokens; tokens *= 10) {
+        std::string text = generate(tokens, gen);
+        parse("parseExpression, " + std::to_string(tokens) + " tokens", text, tokens);
+        std::string simple = generateSimple(tokens, gen);
+        bench::report("infixToRPN, " + std::to_string(tokens) + " tokens", bench::measure([&] {
+            bench::doNotOptimize(infixToRPN(simple));
+        }), tokens);
+        parse("parseExpression, same text", simple, tokens);
+    }
+
+    std::size_t n = maxTokens / 2;
+    parse("nested parentheses", std::string(n, '(') + "x" + std::string(n, ')'), 2 * n + 1);
+    parse("unary minus chain", std::string(maxTokens, '-') + "x", maxTokens + 1);
+    std::string power = "x";
+    for (std::size_t i = 0; i < n; ++i) power += "^x";
+    parse("^ chain", power, 2 * n + 1);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "../BatchServer.h"
+#include "BenchUtils.h"
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The batch mode on generated records: a few hundred distinct formulas over a..e, each record binding
+// fresh values. Times reading (with the expression cache) once and evaluation with 1, 2, 4, ... threads
+// up to the given maximum, and checks every thread count gives the same results.
+// Usage: Lab5ServerBench [records] [max threads]
+namespace
+{
+    std::string generateFormula(std::mt19937& gen)
+    {
+        const char* terms[] = { "a", "b", "c", "d", "e", "2.5", "sqrt(a*a + b*b)", "exp(-c)", "max(d, e)",
+                                "log(1 + e*e)", "(a - b)^2", "sin(c) * cos(d)" };
+        const char* ops[] = { " + ", " - ", " * ", " / " };
+        std::string formula = terms[gen() % 12];
+        std::size_t count = 4 + gen() % 12;
+        for (std::size_t i = 0; i < count; ++i) {
+            formula += ops[gen() % 4];
+            formula += terms[gen() % 12];
+        }
+        return formula;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t records = bench::argOr(argc, argv, 1, 1000000);
+    unsigned maxThreads = static_cast<unsigned>(bench::argOr(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency())));
+    std::mt19937 gen(47);
+
+    std::vector<std::string> formulas;
+    for (int i = 0; i < 300; ++i) formulas.push_back(generateFormula(gen));
+    std::uniform_real_distribution<double> valueDist(-5.0, 5.0);
+    std::string text;
+    char number[32];
+    for (std::size_t r = 0; r < records; ++r) {
+        text += formulas[gen() % formulas.size()];
+        text += ';';
+        for (char name = 'a'; name <= 'e'; ++name) {
+            text += ' ';
+            text += name;
+            text += '=';
+            text.append(number, std::to_chars(number, number + sizeof(number), valueDist(gen)).ptr);
+        }
+        text += '\n';
+    }
+
+    RecordBatch batch;
+    double readSeconds = bench::measure([&] { batch = readRecords(std::string_view(text)); });
+    std::cout << "records: " << records << ", " << text.size() / 1e6 << " MB, distinct expressions: "
+              << batch.cache.size() << ", cache hits: " << batch.cache.hits() << std::endl;
+    bench::report("read and compile", readSeconds, records);
+
+    std::vector<RecordResult> expected, results;
+    double base = 0;
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(maxThreads);
+    for (unsigned threads : counts) {
+        double seconds = bench::measure([&] { evaluateRecords(batch, results, threads); });
+        if (threads == 1) {
+            base = seconds;
+            expected = results;
+        }
+        bench::report("evaluate, " + std::to_string(threads) + " thread(s)", seconds, records);
+        std::cout << "  scaling " << std::setprecision(2) << base / seconds << "x" << std::endl;
+        for (std::size_t i = 0; i < records; ++i) {
+            bool same = results[i].error == expected[i].error &&
+                        (results[i].value == expected[i].value || (results[i].value != results[i].value && expected[i].value != expected[i].value));
+            if (!same) {
+                std::cerr << "record " << i << " differs with " << threads << " threads" << std::endl;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "../Bytecode.h"
+#include "../RPN.h"
+#include "../StaticExpr.h"
+#include "BenchUtils.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A formula known at build time, evaluated over many bindings by evaluateRPN(), by the compiled
+// program and by its evaluateStatic<> instantiation.
+// Usage: Lab5StaticBench [evaluations]
+namespace
+{
+    template <FixedString Formula>
+    bool run(std::size_t n, const std::vector<Bindings>& rows)
+    {
+        std::string rpn = infixToRPN(Formula.text);
+        Program program = compileRPN(rpn);
+        std::cout << Formula.text << std::endl;
+
+        std::unordered_map<char, double> values;
+        double sumString = 0, sumProgram = 0, sumStatic = 0;
+        double tString = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                const Bindings& row = rows[i % rows.size()];
+                for (char var : { 'a', 'b', 'c', 'd', 'e' }) values[var] = row[variableSlot(var)];
+                sumString += evaluateRPN(rpn, values);
+            }
+        });
+        double tProgram = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) sumProgram += evaluate(program, rows[i % rows.size()]);
+        });
+        double tStatic = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) sumStatic += evaluateStatic<Formula>(rows[i % rows.size()]);
+        });
+        bench::report("  evaluateRPN", tString, n);
+        bench::report("  compiled program", tProgram, n);
+        bench::report("  evaluateStatic", tStatic, n);
+        if (sumString != sumProgram || sumString != sumStatic) {
+            std::cerr << "results differ: " << sumString << ", " << sumProgram << ", " << sumStatic << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+
+    // Divisors stay away from zero so that no evaluation throws.
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> valueDist(1.0, 100.0);
+    std::vector<Bindings> rows(1024);
+    for (auto& row : rows) {
+        for (char var : { 'a', 'b', 'c', 'd', 'e' }) row[variableSlot(var)] = valueDist(gen);
+    }
+
+    std::cout << "evaluations per formula: " << n << std::endl;
+    bool ok = run<"(a+b)*c/d">(n, rows) &&
+              run<"a*b+c*d-e">(n, rows) &&
+              run<"(a-b)*(c+d)/(e+a)-b*c+d/e">(n, rows) &&
+              run<"((a+b)*(c-d)+(e*a-b)/(c+d*e))*(a-b/c)+d*(e-a)/(b+c)">(n, rows);
+    return ok ? 0 : 1;
+}
@@ -1,134 +1,102 @@
+#include <charconv>
+#include <chrono>
+#include <fstream>
 #include <iostream>
-#include <stack>
-#include <sstream>
-#include <unordered_map>
+#include <string>
+#include <string_view>
 #include <vector>
-#include <cctype>
 #include <limits>
+#include "BatchServer.h"
+#include "Parser.h"
 
-int precedence(char op) {
-    if (op == '+' || op == '-') return 1;
-    if (op == '*' || op == '/') return 2;
-    return 0;
-}
-
-bool isValidExpression(const std::string& expression) {
-    int balance = 0;
-    for (char ch : expression) {
-        if (!(std::isalpha(ch) || std::isspace(ch) || ch == '+' || ch == '-' || ch == '*' || ch == '/' || ch == '(' || ch == ')')) {
-            std::cout << "Error: Invalid character '" << ch << "' in expression.\n";
-            return false;
-        }
-        if (ch == '(') balance++;
-        if (ch == ')') balance--;
-        if (balance < 0) {
-            std::cout << "Error: Mismatched parentheses.\n";
-            return false;
-        }
-    }
-    if (balance != 0) {
-        std::cout << "Error: Mismatched parentheses.\n";
-        return false;
+double getValidatedInput(const std::string& var) {
+    double value;
+    while (true) {
+        std::cout << "Enter value for " << var << ": ";
+        if (std::cin >> value) return value;
+        std::cout << "Invalid input. Please enter a number.\n";
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     }
-    return true;
 }
 
-std::string infixToRPN(const std::string& expression) {
-    std::stack<char> operators;
-    std::stringstream output;
-    for (size_t i = 0; i < expression.size(); ++i) {
-        char ch = expression[i];
-        if (std::isspace(ch)) continue;
-        if (std::isalpha(ch)) {
-            output << ch << ' ';
-        }
-        else if (ch == '(') {
-            operators.push(ch);
-        }
-        else if (ch == ')') {
-            while (!operators.empty() && operators.top() != '(') {
-                output << operators.top() << ' ';
-                operators.pop();
-            }
-            operators.pop();
-        }
-        else {
-            while (!operators.empty() && precedence(operators.top()) >= precedence(ch)) {
-                output << operators.top() << ' ';
-                operators.pop();
-            }
-            operators.push(ch);
+// Lab5 <records file, or - for stdin> [results file, or - for stdout] [threads, 0 for all cores]
+// Evaluates every record (see BatchServer.h) and writes one result per line, in input order, to the
+// results file or stdout. Timings go to stderr.
+int runBatch(int argc, char* argv[]) {
+    std::string input = argv[1];
+    std::ifstream file;
+    if (input != "-") {
+        file.open(input, std::ios::binary);
+        if (!file) {
+            std::cerr << "Cannot open " << input << std::endl;
+            return 1;
         }
     }
-    while (!operators.empty()) {
-        output << operators.top() << ' ';
-        operators.pop();
+    unsigned threads = 0;
+    if (argc > 3) {
+        std::string_view text = argv[3];
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), threads);
+        if (error != std::errc() || end != text.data() + text.size()) {
+            std::cerr << "Invalid thread count " << text << std::endl;
+            return 1;
+        }
     }
-    return output.str();
-}
 
-double evaluateRPN(const std::string& rpn, const std::unordered_map<char, double>& values) {
-    std::stack<double> operands;
-    std::stringstream tokens(rpn);
-    std::string token;
-    while (tokens >> token) {
-        if (std::isalpha(token[0])) {
-            operands.push(values.at(token[0]));
-        }
-        else {
-            if (operands.size() < 2) {
-                throw std::runtime_error("Error: Malformed expression.");
-            }
-            double b = operands.top(); operands.pop();
-            double a = operands.top(); operands.pop();
-            switch (token[0]) {
-            case '+': operands.push(a + b); break;
-            case '-': operands.push(a - b); break;
-            case '*': operands.push(a * b); break;
-            case '/':
-                if (b == 0) throw std::runtime_error("Error: Division by zero.");
-                operands.push(a / b);
-                break;
-            default: throw std::runtime_error("Error: Unknown operator.");
-            }
+    auto start = std::chrono::steady_clock::now();
+    RecordBatch batch = readRecords(input == "-" ? std::cin : file);
+    auto read = std::chrono::steady_clock::now();
+    std::vector<RecordResult> results;
+    evaluateRecords(batch, results, threads);
+    auto evaluated = std::chrono::steady_clock::now();
+
+    if (argc > 2 && std::string(argv[2]) != "-") {
+        std::ofstream out(argv[2], std::ios::binary);
+        if (!out) {
+            std::cerr << "Cannot open " << argv[2] << std::endl;
+            return 1;
         }
+        writeResults(out, results);
     }
-    if (operands.size() != 1) {
-        throw std::runtime_error("Error: Malformed expression.");
+    else {
+        writeResults(std::cout, results);
     }
-    return operands.top();
-}
 
-double getValidatedInput(char var) {
-    double value;
-    while (true) {
-        std::cout << "Enter value for " << var << ": ";
-        if (std::cin >> value) return value;
-        std::cout << "Invalid input. Please enter a number.\n";
-        std::cin.clear();
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    }
+    double readSeconds = std::chrono::duration<double>(read - start).count();
+    double evaluateSeconds = std::chrono::duration<double>(evaluated - read).count();
+    std::size_t failed = 0;
+    for (const RecordResult& result : results) failed += !result.error.empty();
+    std::cerr << "Records: " << batch.records.size() << " (" << failed << " with errors), distinct expressions: "
+              << batch.cache.size() << std::endl
+              << "Read and compile: " << readSeconds * 1e3 << " ms, evaluate: " << evaluateSeconds * 1e3 << " ms ("
+              << batch.records.size() / evaluateSeconds << " records/s)" << std::endl;
+    return 0;
 }
 
-int main() {
-    std::string expression;
-    std::cout << "Enter expression (use variables a, b, c, d, e): ";
-    std::getline(std::cin, expression);
+int main(int argc, char* argv[]) {
+    if (argc > 1) return runBatch(argc, argv);
 
-    if (!isValidExpression(expression)) {
+    std::string text;
+    std::cout << "Enter expression (numbers, variables, + - * / ^, sqrt abs exp log sin cos min max pow): ";
+    std::getline(std::cin, text);
+
+    Expression expression;
+    try {
+        expression = parseExpression(text);
+    }
+    catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
         return 1;
     }
+    std::cout << "Reverse Polish Notation: " << toRPN(expression) << std::endl;
 
-    std::string rpn = infixToRPN(expression);
-    std::cout << "Reverse Polish Notation: " << rpn << std::endl;
-
-    std::unordered_map<char, double> values;
-    for (char var : {'a', 'b', 'c', 'd', 'e'}) {
-        values[var] = getValidatedInput(var);
+    std::vector<double> values;
+    for (const std::string& var : expression.variables) {
+        values.push_back(getValidatedInput(var));
     }
 
     try {
-        double result = evaluateRPN(rpn, values);
+        double result = evaluate(expression, values);
         std::cout << "Result: " << result << std::endl;
     }
     catch (const std::exception& e) {
@@ -0,0 +1,325 @@
+#ifndef CONTAINER_CONCURRENT_MAP_HPP
+#define CONTAINER_CONCURRENT_MAP_HPP
+
+#include "EpochDomain.h"
+#include "Map.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace container
+{
+    namespace detail
+    {
+        // Immutable once published: writers never modify a reachable node, they copy the search path.
+        template <typename Key, typename Value>
+        struct SharedNode {
+            using value_type = std::pair<Key, Value>;
+            value_type data;
+            const SharedNode* left;
+            const SharedNode* right;
+            int height;
+
+            SharedNode(const value_type& val, const SharedNode* l, const SharedNode* r)
+                : data(val), left(l), right(r),
+                  height(1 + std::max(l ? l->height : 0, r ? r->height : 0)) {}
+        };
+    } // namespace detail
+
+
+    // Ordered map for read-mostly workloads. Lookups never block: they read an immutable snapshot
+    // published through an atomic root. Writers are serialized by a mutex and publish a path-copied
+    // tree; the replaced nodes are reclaimed once no reader can still reach them.
+    template <detail::Tree_type Key, detail::Tree_type Value,
+        typename Compare = std::less<Key>,
+        typename Allocator = std::allocator<std::pair<Key, Value>>>
+    class ConcurrentMap {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using key_compare = Compare;
+        using node_type = detail::SharedNode<Key, Value>;
+        using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+        using allocator_type = NodeAllocator;
+
+        static constexpr std::size_t reader_slots = 128;
+
+        explicit ConcurrentMap(NodeAllocator allocator = NodeAllocator())
+            : m_alloc(allocator) {}
+
+        ConcurrentMap(const ConcurrentMap&) = delete;
+        ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+
+        // Requires that no other thread is still using the map.
+        ~ConcurrentMap() {
+            for (auto& batch : m_limbo)
+                for (const node_type* node : batch.nodes) freeNode(node);
+            destroy(m_root.load(std::memory_order_relaxed));
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const {
+            return m_alloc;
+        }
+
+        // Readers
+
+        std::optional<mapped_type> find(const key_type& key) const {
+            return read([&](const node_type* root) -> std::optional<mapped_type> {
+                if (const node_type* node = findNode(root, key)) return node->data.second;
+                return std::nullopt;
+            });
+        }
+
+        bool contains(const key_type& key) const {
+            return read([&](const node_type* root) { return findNode(root, key) != nullptr; });
+        }
+
+        // Calls fn(key, value) for every element with lo <= key <= hi, on one consistent snapshot.
+        template <typename Fn>
+        void for_each_in_range(const key_type& lo, const key_type& hi, Fn&& fn) const {
+            read([&](const node_type* root) {
+                visitRange(root, lo, hi, fn);
+                return 0;
+            });
+        }
+
+        [[nodiscard]] size_type size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        // Writers
+
+        // Returns false if the key was already present; the stored value is kept, as in Map::insert.
+        bool insert(const value_type& val) {
+            return write([&](const node_type* root) { return insertUtil(root, val, false); }, +1);
+        }
+
+        // Returns false if an existing value was replaced.
+        bool insert_or_assign(const value_type& val) {
+            return write([&](const node_type* root) { return insertUtil(root, val, true); }, +1);
+        }
+
+        bool remove(const key_type& key) {
+            return write([&](const node_type* root) { return removeUtil(root, key); }, -1);
+        }
+
+    private:
+        struct Retired {
+            std::uint64_t epoch;
+            std::vector<const node_type*> nodes;
+        };
+
+        // Result of a path-copying update: the new subtree and whether an element was added or removed.
+        struct Update {
+            const node_type* head;
+            bool changed;
+        };
+
+        static constexpr std::size_t reclaim_batches = 32;
+
+        std::atomic<const node_type*> m_root{ nullptr };
+        std::atomic<size_type> m_size{ 0 };
+        Compare m_comp;
+        mutable NodeAllocator m_alloc;
+        mutable reclaim::EpochDomain<reader_slots> m_epochs;
+        mutable std::mutex m_writeMutex;
+        std::vector<const node_type*> m_retired; // nodes unlinked by the write in progress
+        std::vector<const node_type*> m_created; // nodes made by the write in progress
+        std::vector<Retired> m_limbo;
+
+        template <typename Fn>
+        auto read(Fn&& fn) const {
+            typename reclaim::EpochDomain<reader_slots>::Guard guard(m_epochs);
+            if (guard) return fn(m_root.load(std::memory_order_seq_cst));
+            // Every announcement slot is taken: fall back to reading under the writer lock.
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            return fn(m_root.load(std::memory_order_relaxed));
+        }
+
+        template <typename Fn>
+        bool write(Fn&& fn, int sizeDelta) {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            Update result;
+            try {
+                result = fn(m_root.load(std::memory_order_relaxed));
+            }
+            catch (...) {
+                // The old root is still published and everything in m_retired is still reachable from it;
+                // only the nodes of the abandoned path go.
+                for (const node_type* node : m_created) freeNode(node);
+                m_created.clear();
+                m_retired.clear();
+                throw;
+            }
+            m_created.clear();
+            if (result.changed) {
+                if (sizeDelta > 0) m_size.fetch_add(1, std::memory_order_relaxed);
+                else m_size.fetch_sub(1, std::memory_order_relaxed);
+            }
+            if (m_retired.empty() && result.head == m_root.load(std::memory_order_relaxed))
+                return result.changed;
+
+            m_root.store(result.head, std::memory_order_seq_cst);
+            std::uint64_t epoch = m_epochs.advance();
+            m_limbo.push_back({ epoch, std::move(m_retired) });
+            m_retired.clear();
+            if (m_limbo.size() >= reclaim_batches) reclaim();
+            return result.changed;
+        }
+
+        void reclaim() {
+            std::uint64_t oldest = m_epochs.oldestActive();
+            auto keep = m_limbo.begin();
+            for (auto it = m_limbo.begin(); it != m_limbo.end(); ++it) {
+                if (it->epoch < oldest) {
+                    for (const node_type* node : it->nodes) freeNode(node);
+                }
+                else {
+                    if (keep != it) *keep = std::move(*it);
+                    ++keep;
+                }
+            }
+            m_limbo.erase(keep, m_limbo.end());
+        }
+
+        // The node is recorded in m_created, so a write that throws part way can free it again.
+        const node_type* makeNode(const value_type& val, const node_type* l, const node_type* r) {
+            if (m_created.size() == m_created.capacity()) m_created.reserve(2 * m_created.size() + 16);
+            node_type* node = std::allocator_traits<NodeAllocator>::allocate(m_alloc, 1);
+            try {
+                std::allocator_traits<NodeAllocator>::construct(m_alloc, node, val, l, r);
+            }
+            catch (...) {
+                std::allocator_traits<NodeAllocator>::deallocate(m_alloc, node, 1);
+                throw;
+            }
+            m_created.push_back(node);
+            return node;
+        }
+
+        void freeNode(const node_type* node) const {
+            node_type* mutableNode = const_cast<node_type*>(node);
+            std::allocator_traits<NodeAllocator>::destroy(m_alloc, mutableNode);
+            std::allocator_traits<NodeAllocator>::deallocate(m_alloc, mutableNode, 1);
+        }
+
+        void destroy(const node_type* head) {
+            if (!head) return;
+            destroy(head->left);
+            destroy(head->right);
+            freeNode(head);
+        }
+
+        void retire(const node_type* node) {
+            m_retired.push_back(node);
+        }
+
+        static int height(const node_type* head) {
+            return head ? head->height : 0;
+        }
+
+        // Builds a balanced node from data and two AVL subtrees whose heights differ by at most 2.
+        // Nodes taken apart by a rotation are retired.
+        const node_type* balanced(const value_type& data, const node_type* l, const node_type* r) {
+            int bal = height(l) - height(r);
+            if (bal > 1) {
+                retire(l);
+                if (height(l->left) >= height(l->right))
+                    return makeNode(l->data, l->left, makeNode(data, l->right, r));
+                const node_type* lr = l->right;
+                retire(lr);
+                return makeNode(lr->data, makeNode(l->data, l->left, lr->left), makeNode(data, lr->right, r));
+            }
+            if (bal < -1) {
+                retire(r);
+                if (height(r->right) >= height(r->left))
+                    return makeNode(r->data, makeNode(data, l, r->left), r->right);
+                const node_type* rl = r->left;
+                retire(rl);
+                return makeNode(rl->data, makeNode(data, l, rl->left), makeNode(r->data, rl->right, r->right));
+            }
+            return makeNode(data, l, r);
+        }
+
+        Update insertUtil(const node_type* head, const value_type& val, bool assign) {
+            if (!head) return { makeNode(val, nullptr, nullptr), true };
+            if (m_comp(val.first, head->data.first)) {
+                Update sub = insertUtil(head->left, val, assign);
+                if (sub.head == head->left) return { head, sub.changed };
+                retire(head);
+                return { balanced(head->data, sub.head, head->right), sub.changed };
+            }
+            if (m_comp(head->data.first, val.first)) {
+                Update sub = insertUtil(head->right, val, assign);
+                if (sub.head == head->right) return { head, sub.changed };
+                retire(head);
+                return { balanced(head->data, head->left, sub.head), sub.changed };
+            }
+            if (!assign) return { head, false };
+            retire(head);
+            return { makeNode(val, head->left, head->right), false };
+        }
+
+        // Removes the smallest node of a non-empty subtree; its data is copied out to min.
+        const node_type* removeMin(const node_type* head, const value_type*& min) {
+            retire(head);
+            if (!head->left) {
+                min = &head->data;
+                return head->right;
+            }
+            const node_type* left = removeMin(head->left, min);
+            return balanced(head->data, left, head->right);
+        }
+
+        Update removeUtil(const node_type* head, const key_type& key) {
+            if (!head) return { nullptr, false };
+            if (m_comp(key, head->data.first)) {
+                Update sub = removeUtil(head->left, key);
+                if (!sub.changed) return { head, false };
+                retire(head);
+                return { balanced(head->data, sub.head, head->right), true };
+            }
+            if (m_comp(head->data.first, key)) {
+                Update sub = removeUtil(head->right, key);
+                if (!sub.changed) return { head, false };
+                retire(head);
+                return { balanced(head->data, head->left, sub.head), true };
+            }
+            retire(head);
+            if (!head->left) return { head->right, true };
+            if (!head->right) return { head->left, true };
+            const value_type* min = nullptr;
+            const node_type* right = removeMin(head->right, min);
+            return { balanced(*min, head->left, right), true };
+        }
+
+        const node_type* findNode(const node_type* current, const key_type& key) const {
+            while (current) {
+                if (m_comp(key, current->data.first)) current = current->left;
+                else if (m_comp(current->data.first, key)) current = current->right;
+                else return current;
+            }
+            return nullptr;
+        }
+
+        template <typename Fn>
+        void visitRange(const node_type* head, const key_type& lo, const key_type& hi, Fn& fn) const {
+            if (!head) return;
+            bool aboveLo = m_comp(lo, head->data.first);
+            bool belowHi = m_comp(head->data.first, hi);
+            if (aboveLo) visitRange(head->left, lo, hi, fn);
+            if (!m_comp(head->data.first, lo) && !m_comp(hi, head->data.first))
+                fn(head->data.first, head->data.second);
+            if (belowHi) visitRange(head->right, lo, hi, fn);
+        }
+    };
+
+} // namespace container
+
+#endif // CONTAINER_CONCURRENT_MAP_HPP
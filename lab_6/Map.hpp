@@ -7,6 +7,9 @@
 #include <iostream>
 #include <type_traits>
 #include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <cmath>
 
 namespace container
 {
@@ -32,15 +35,20 @@ namespace container
             Node* right;
             Node* parent;
             int height;
+            std::size_t size; // number of nodes in the subtree rooted here
 
             explicit Node(const value_type& val, Node* p = nullptr)
-                : data(val), left(nullptr), right(nullptr), parent(p), height(0) {}
+                : data(val), left(nullptr), right(nullptr), parent(p), height(1), size(1) {}
+
+            explicit Node(value_type&& val, Node* p = nullptr)
+                : data(std::move(val)), left(nullptr), right(nullptr), parent(p), height(1), size(1) {}
         };
 
         template <typename NodeType>
         struct AVLTreeIterator
         {
-            using value_type = typename NodeType::value_type;
+            using value_type = std::conditional_t<std::is_const_v<NodeType>,
+                const typename NodeType::value_type, typename NodeType::value_type>;
             using difference_type = std::ptrdiff_t;
             using reference = value_type&;
             using const_reference = const value_type&;
@@ -48,9 +56,20 @@ namespace container
             using const_pointer = const value_type*;
             using iterator_category = std::bidirectional_iterator_tag;
 
+            AVLTreeIterator() = default;
+
             explicit AVLTreeIterator(NodeType* current, bool reverse = false)
                 : m_current(current), m_reverse(reverse) {}
 
+            template <typename OtherNode>
+                requires(std::is_const_v<NodeType> && std::is_same_v<const OtherNode, NodeType>)
+            AVLTreeIterator(const AVLTreeIterator<OtherNode>& other)
+                : m_current(other.node()), m_reverse(other.reversed()) {}
+
+            NodeType* node() const noexcept { return m_current; }
+
+            bool reversed() const noexcept { return m_reverse; }
+
             bool operator==(const AVLTreeIterator& other) const {
                 return other.m_current == m_current && other.m_reverse == m_reverse;
             }
@@ -68,7 +87,7 @@ namespace container
                 return *this;
             }
 
-            AVLTreeIterator& operator++(int) {
+            AVLTreeIterator operator++(int) {
                 AVLTreeIterator tmp = *this;
                 ++(*this);
                 return tmp;
@@ -83,33 +102,17 @@ namespace container
                 return *this;
             }
 
-            AVLTreeIterator& operator--(int) {
+            AVLTreeIterator operator--(int) {
                 AVLTreeIterator tmp = *this;
                 --(*this);
                 return tmp;
             }
 
-            reference operator*()
-                requires(!std::is_const_v<value_type>)
-            {
+            reference operator*() const {
                 return m_current->data;
             }
 
-            const_reference operator*() const
-                requires(std::is_const_v<value_type>)
-            {
-                return m_current->data;
-            }
-
-            pointer operator->()
-                requires(!std::is_const_v<value_type>)
-            {
-                return &m_current->data;
-            }
-
-            const_pointer operator->() const
-                requires(std::is_const_v<value_type>)
-            {
+            pointer operator->() const {
                 return &m_current->data;
             }
 
@@ -154,6 +157,18 @@ namespace container
             }
         };
 
+        // Half-open [first, last) view over a tree, so a key range can be used in range-for.
+        template <typename Iterator>
+        struct AVLTreeRange
+        {
+            Iterator first;
+            Iterator last;
+
+            Iterator begin() const { return first; }
+            Iterator end() const { return last; }
+            bool empty() const { return first == last; }
+        };
+
         template <Tree_type Key, Tree_type Value,
             typename Compare = std::less<Key>,
             typename Allocator = std::allocator<std::pair<Key, Value>>>
@@ -174,6 +189,8 @@ namespace container
             using const_iterator = AVLTreeIterator<const node_type>;
             using reverse_iterator = AVLTreeIterator<node_type>;
             using const_reverse_iterator = AVLTreeIterator<const node_type>;
+            using range_type = AVLTreeRange<iterator>;
+            using const_range_type = AVLTreeRange<const_iterator>;
 
             using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
             using allocator_type = NodeAllocator;
@@ -183,10 +200,39 @@ namespace container
             size_type m_size{};
             Compare m_comp;
             NodeAllocator m_alloc;
+            // Contiguous node blocks from bulk builds: {first node, capacity, live nodes}, sorted by address.
+            struct NodeBlock {
+                node_type* first;
+                size_type capacity;
+                size_type live;
+            };
+            std::vector<NodeBlock> m_blocks;
 
         public:
             explicit AVLTree(NodeAllocator allocator = NodeAllocator())
                 : m_alloc(allocator), m_root(nullptr) {}
+
+            // Deep copy in O(n): the source is already in key order, so it is bulk-built into one block.
+            AVLTree(const AVLTree& other)
+                : m_root(nullptr), m_comp(other.m_comp),
+                  m_alloc(std::allocator_traits<NodeAllocator>::select_on_container_copy_construction(other.m_alloc)) {
+                buildSorted(other.cbegin(), other.cend());
+            }
+
+            AVLTree(AVLTree&& other) noexcept
+                : m_root(std::exchange(other.m_root, nullptr)), m_size(std::exchange(other.m_size, 0)),
+                  m_comp(std::move(other.m_comp)), m_alloc(std::move(other.m_alloc)),
+                  m_blocks(std::exchange(other.m_blocks, {})) {}
+
+            AVLTree& operator=(AVLTree other) noexcept {
+                std::swap(m_root, other.m_root);
+                std::swap(m_size, other.m_size);
+                std::swap(m_comp, other.m_comp);
+                std::swap(m_alloc, other.m_alloc);
+                std::swap(m_blocks, other.m_blocks);
+                return *this;
+            }
+
             ~AVLTree() { destroy(m_root); }
 
             [[nodiscard]] allocator_type get_allocator() const {
@@ -228,6 +274,89 @@ namespace container
                 m_root = removeUtil(m_root, x);
             }
 
+            void clear() {
+                destroy(m_root);
+                m_root = nullptr;
+                m_size = 0;
+            }
+
+            // Bulk operations
+
+            // Replaces the contents with [first, last) in O(n) when the input is already sorted by key,
+            // O(n log n) otherwise. For duplicate keys the first occurrence wins, as with insert().
+            template <std::input_iterator InputIt>
+            void build(InputIt first, InputIt last) {
+                clear();
+                if constexpr (std::forward_iterator<InputIt>) {
+                    if (std::is_sorted(first, last, keyLess())) {
+                        buildSorted(first, last);
+                        return;
+                    }
+                }
+                std::vector<value_type> sorted(first, last);
+                if (!std::is_sorted(sorted.begin(), sorted.end(), keyLess()))
+                    std::stable_sort(sorted.begin(), sorted.end(), keyLess());
+                buildSorted(std::make_move_iterator(sorted.begin()), std::make_move_iterator(sorted.end()));
+            }
+
+            // Inserts a batch of values. Large batches are merged with the existing in-order sequence and the
+            // tree is relinked in O(n + m); small ones fall back to insert(). Existing keys keep their values.
+            template <std::input_iterator InputIt>
+            void merge_sorted(InputIt first, InputIt last) {
+                std::vector<value_type> batch(first, last);
+                if (!std::is_sorted(batch.begin(), batch.end(), keyLess()))
+                    std::stable_sort(batch.begin(), batch.end(), keyLess());
+
+                double perInsert = std::log2(static_cast<double>(m_size + batch.size()) + 1.0);
+                if (static_cast<double>(batch.size()) * perInsert < static_cast<double>(m_size)) {
+                    for (const auto& val : batch) insert(val);
+                    return;
+                }
+
+                std::vector<node_type*> nodes;
+                nodes.reserve(m_size);
+                collectInorder(nodes);
+
+                // Keys that are not in the map yet; they share one allocation.
+                std::vector<const value_type*> fresh;
+                size_type i = 0;
+                for (size_type j = 0; j < batch.size(); ++j) {
+                    if (j > 0 && !m_comp(batch[j - 1].first, batch[j].first)) continue;
+                    while (i < nodes.size() && m_comp(nodes[i]->data.first, batch[j].first)) ++i;
+                    if (i == nodes.size() || m_comp(batch[j].first, nodes[i]->data.first))
+                        fresh.push_back(&batch[j]);
+                }
+                if (fresh.empty()) return;
+
+                // Everything that can throw once the new nodes exist is done before they are made.
+                std::vector<node_type*> merged;
+                merged.reserve(nodes.size() + fresh.size());
+                node_type* block = allocateBlock(fresh.size());
+                size_type constructed = 0;
+                try {
+                    for (const value_type* val : fresh)
+                        std::allocator_traits<NodeAllocator>::construct(m_alloc, block + constructed++, *val);
+                }
+                catch (...) {
+                    while (constructed) std::allocator_traits<NodeAllocator>::destroy(m_alloc, block + --constructed);
+                    discardBlock(block);
+                    throw;
+                }
+                blockOf(block)->live = fresh.size();
+
+                size_type k = 0;
+                i = 0;
+                while (i < nodes.size() || k < fresh.size()) {
+                    if (k == fresh.size() || (i < nodes.size() && m_comp(nodes[i]->data.first, block[k].data.first)))
+                        merged.push_back(nodes[i++]);
+                    else
+                        merged.push_back(block + k++);
+                }
+
+                m_size = merged.size();
+                m_root = link(merged.data(), 0, merged.size(), nullptr);
+            }
+
             iterator find(const key_type& key) {
                 node_type* node = findNode(key);
                 if (node)
@@ -239,11 +368,62 @@ namespace container
             const_iterator find(const key_type& key) const {
                 node_type* node = findNode(key);
                 if (node)
-                    return iterator(node);
+                    return const_iterator(node);
                 else
                     return end();
             }
 
+            // Ordered lookup
+
+            // First element whose key is not less than `key`.
+            iterator lower_bound(const key_type& key) { return iterator(lowerBoundNode(key)); }
+
+            const_iterator lower_bound(const key_type& key) const {
+                return const_iterator(lowerBoundNode(key));
+            }
+
+            // First element whose key is greater than `key`.
+            iterator upper_bound(const key_type& key) { return iterator(upperBoundNode(key)); }
+
+            const_iterator upper_bound(const key_type& key) const {
+                return const_iterator(upperBoundNode(key));
+            }
+
+            std::pair<iterator, iterator> equal_range(const key_type& key) {
+                return { lower_bound(key), upper_bound(key) };
+            }
+
+            std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+                return { lower_bound(key), upper_bound(key) };
+            }
+
+            // All elements with lo <= key <= hi, in key order.
+            range_type range(const key_type& lo, const key_type& hi) {
+                if (m_comp(hi, lo)) return { end(), end() };
+                return { lower_bound(lo), upper_bound(hi) };
+            }
+
+            const_range_type range(const key_type& lo, const key_type& hi) const {
+                if (m_comp(hi, lo)) return { end(), end() };
+                return { lower_bound(lo), upper_bound(hi) };
+            }
+
+            // Number of elements with lo <= key <= hi, O(log n).
+            [[nodiscard]] size_type count_range(const key_type& lo, const key_type& hi) const {
+                if (m_comp(hi, lo)) return 0;
+                return countLess(hi, true) - countLess(lo, false);
+            }
+
+            // Order statistics
+
+            // k-th smallest element (0-based), end() if k >= size().
+            iterator nth(size_type k) { return iterator(nthNode(k)); }
+
+            const_iterator nth(size_type k) const { return const_iterator(nthNode(k)); }
+
+            // Number of elements whose key is less than `key`.
+            [[nodiscard]] size_type rank(const key_type& key) const { return countLess(key, false); }
+
             // Iterators 
 
             iterator begin() { return iterator(min()); }
@@ -308,22 +488,138 @@ namespace container
                 if (!head) return;
                 destroy(head->left);
                 destroy(head->right);
-                std::allocator_traits<NodeAllocator>::destroy(m_alloc, head);
-                std::allocator_traits<NodeAllocator>::deallocate(m_alloc, head, 1);
+                freeNode(head);
+            }
+
+            // Destroys a node and returns its memory, releasing a bulk block once its last node is gone.
+            void freeNode(node_type* node) {
+                std::allocator_traits<NodeAllocator>::destroy(m_alloc, node);
+                auto it = blockOf(node);
+                if (it == m_blocks.end()) {
+                    std::allocator_traits<NodeAllocator>::deallocate(m_alloc, node, 1);
+                }
+                else if (--it->live == 0) {
+                    std::allocator_traits<NodeAllocator>::deallocate(m_alloc, it->first, it->capacity);
+                    m_blocks.erase(it);
+                }
+            }
+
+            // The block holding node, found by binary search over m_blocks (kept sorted by address), or
+            // m_blocks.end() for a node allocated on its own.
+            typename std::vector<NodeBlock>::iterator blockOf(const node_type* node) {
+                std::less<const node_type*> before;
+                auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), node,
+                    [&](const node_type* p, const NodeBlock& block) { return before(p, block.first); });
+                if (it == m_blocks.begin()) return m_blocks.end();
+                --it;
+                return before(node, it->first + it->capacity) ? it : m_blocks.end();
+            }
+
+            // Room for count nodes, none of them constructed or live yet.
+            node_type* allocateBlock(size_type count) {
+                node_type* block = std::allocator_traits<NodeAllocator>::allocate(m_alloc, count);
+                std::less<const node_type*> before;
+                auto pos = std::upper_bound(m_blocks.begin(), m_blocks.end(), block,
+                    [&](const node_type* p, const NodeBlock& other) { return before(p, other.first); });
+                try {
+                    m_blocks.insert(pos, { block, count, 0 });
+                }
+                catch (...) {
+                    std::allocator_traits<NodeAllocator>::deallocate(m_alloc, block, count);
+                    throw;
+                }
+                return block;
+            }
+
+            // Gives back a block from allocateBlock() whose nodes have all been destroyed.
+            void discardBlock(node_type* block) {
+                auto it = blockOf(block);
+                std::allocator_traits<NodeAllocator>::deallocate(m_alloc, it->first, it->capacity);
+                m_blocks.erase(it);
+            }
+
+            auto keyLess() const {
+                return [this](const auto& a, const auto& b) { return m_comp(a.first, b.first); };
+            }
+
+            // It only needs to be a multi-pass iterator over value_type in key order. The second pass compares
+            // against the last node built rather than *prev, which a move iterator has already moved from.
+            template <typename It>
+            void buildSorted(It first, It last) {
+                size_type count = 0;
+                for (It it = first, prev = first; it != last; prev = it, ++it)
+                    if (it == first || m_comp((*prev).first, (*it).first)) ++count;
+                if (count == 0) return;
+
+                std::vector<node_type*> nodes(count);
+                node_type* block = allocateBlock(count);
+                size_type constructed = 0;
+                try {
+                    for (It it = first; it != last; ++it)
+                        if (constructed == 0 || m_comp(block[constructed - 1].data.first, (*it).first))
+                            std::allocator_traits<NodeAllocator>::construct(m_alloc, block + constructed++, *it);
+                }
+                catch (...) {
+                    while (constructed) std::allocator_traits<NodeAllocator>::destroy(m_alloc, block + --constructed);
+                    discardBlock(block);
+                    throw;
+                }
+
+                for (size_type i = 0; i < count; ++i) nodes[i] = block + i;
+                blockOf(block)->live = count;
+                m_size = count;
+                m_root = link(nodes.data(), 0, count, nullptr);
+            }
+
+            // Links nodes[lo, hi), already in key order, into a perfectly balanced subtree.
+            node_type* link(node_type** nodes, size_type lo, size_type hi, node_type* parent) {
+                if (lo == hi) return nullptr;
+                size_type mid = lo + (hi - lo) / 2;
+                node_type* head = nodes[mid];
+                head->parent = parent;
+                head->left = link(nodes, lo, mid, head);
+                head->right = link(nodes, mid + 1, hi, head);
+                update(head);
+                return head;
+            }
+
+            void collectInorder(std::vector<node_type*>& out) const {
+                std::vector<node_type*> stack;
+                node_type* current = m_root;
+                while (current || !stack.empty()) {
+                    while (current) {
+                        stack.push_back(current);
+                        current = current->left;
+                    }
+                    current = stack.back();
+                    stack.pop_back();
+                    out.push_back(current);
+                    current = current->right;
+                }
             }
 
             int height(node_type* head) {
                 return head ? head->height : 0;
             }
 
+            static size_type subtreeSize(const node_type* head) {
+                return head ? head->size : 0;
+            }
+
+            void update(node_type* head) {
+                head->height = 1 + std::max(height(head->left), height(head->right));
+                head->size = 1 + subtreeSize(head->left) + subtreeSize(head->right);
+            }
+
             node_type* rightRotation(node_type* head) {
                 node_type* newhead = head->left;
                 head->left = newhead->right;
                 if (newhead->right) newhead->right->parent = head;
                 newhead->right = head;
+                newhead->parent = head->parent;
                 head->parent = newhead;
-                head->height = 1 + std::max(height(head->left), height(head->right));
-                newhead->height = 1 + std::max(height(newhead->left), height(newhead->right));
+                update(head);
+                update(newhead);
                 return newhead;
             }
 
@@ -332,12 +628,33 @@ namespace container
                 head->right = newhead->left;
                 if (newhead->left) newhead->left->parent = head;
                 newhead->left = head;
+                newhead->parent = head->parent;
                 head->parent = newhead;
-                head->height = 1 + std::max(height(head->left), height(head->right));
-                newhead->height = 1 + std::max(height(newhead->left), height(newhead->right));
+                update(head);
+                update(newhead);
                 return newhead;
             }
 
+            int balance(node_type* head) {
+                return height(head->left) - height(head->right);
+            }
+
+            // Restores the AVL invariant at head; the rotation case is chosen by the child's balance.
+            node_type* rebalance(node_type* head) {
+                update(head);
+                int bal = balance(head);
+
+                if (bal > 1) {
+                    if (balance(head->left) < 0) head->left = leftRotation(head->left);
+                    return rightRotation(head);
+                }
+                if (bal < -1) {
+                    if (balance(head->right) > 0) head->right = rightRotation(head->right);
+                    return leftRotation(head);
+                }
+                return head;
+            }
+
             void inorderUtil(node_type* head) {
                 if (!head) return;
                 inorderUtil(head->left);
@@ -370,20 +687,7 @@ namespace container
                 if (m_comp(val.first, head->data.first)) head->left = insertUtil(head->left, val, head);
                 else if (m_comp(head->data.first, val.first)) head->right = insertUtil(head->right, val, head);
 
-                head->height = 1 + std::max(height(head->left), height(head->right));
-                int bal = height(head->left) - height(head->right);
-
-                if (bal > 1) {
-                    if (m_comp(val.first, head->left->data.first)) return rightRotation(head);
-                    head->left = leftRotation(head->left);
-                    return rightRotation(head);
-                }
-                if (bal < -1) {
-                    if (m_comp(head->right->data.first, val.first)) return leftRotation(head);
-                    head->right = rightRotation(head->right);
-                    return leftRotation(head);
-                }
-                return head;
+                return rebalance(head);
             }
 
             node_type* removeUtil(node_type* head, const key_type& x) {
@@ -394,13 +698,15 @@ namespace container
                     node_type* r = head->right;
                     if (!r) {
                         node_type* l = head->left;
-                        std::allocator_traits<NodeAllocator>::destroy(m_alloc, head);
-                        std::allocator_traits<NodeAllocator>::deallocate(m_alloc, head, 1);
+                        if (l) l->parent = head->parent;
+                        freeNode(head);
+                        --m_size;
                         head = l;
                     }
                     else if (!head->left) {
-                        std::allocator_traits<NodeAllocator>::destroy(m_alloc, head);
-                        std::allocator_traits<NodeAllocator>::deallocate(m_alloc, head, 1);
+                        r->parent = head->parent;
+                        freeNode(head);
+                        --m_size;
                         head = r;
                     }
                     else {
@@ -410,45 +716,98 @@ namespace container
                     }
                 }
                 if (!head) return head;
-                head->height = 1 + std::max(height(head->left), height(head->right));
-                int bal = height(head->left) - height(head->right);
-
-                if (bal > 1) {
-                    if (height(head->left) >= height(head->right)) return rightRotation(head);
-                    head->left = leftRotation(head->left);
-                    return rightRotation(head);
-                }
-                if (bal < -1) {
-                    if (height(head->right) >= height(head->left)) return leftRotation(head);
-                    head->right = rightRotation(head->right);
-                    return leftRotation(head);
-                }
-                return head;
+                return rebalance(head);
             }
 
-            node_type* minNode(node_type* head) {
+            static node_type* minNode(node_type* head) {
                 while (head && head->left) {
                     head = head->left;
                 }
                 return head;
             }
 
-            node_type* maxNode(node_type* head) {
+            static node_type* maxNode(node_type* head) {
                 while (head && head->right) {
                     head = head->right;
                 }
                 return head;
             }
 
-            node_type* min() {
+            node_type* min() const {
                 return minNode(m_root);
             }
 
-            node_type* max() {
+            node_type* max() const {
                 return maxNode(m_root);
             }
 
-            node_type* findNode(const key_type& key) {
+            node_type* lowerBoundNode(const key_type& key) const {
+                node_type* current = m_root;
+                node_type* result = nullptr;
+                while (current) {
+                    if (m_comp(current->data.first, key)) {
+                        current = current->right;
+                    }
+                    else {
+                        result = current;
+                        current = current->left;
+                    }
+                }
+                return result;
+            }
+
+            node_type* upperBoundNode(const key_type& key) const {
+                node_type* current = m_root;
+                node_type* result = nullptr;
+                while (current) {
+                    if (m_comp(key, current->data.first)) {
+                        result = current;
+                        current = current->left;
+                    }
+                    else {
+                        current = current->right;
+                    }
+                }
+                return result;
+            }
+
+            // Number of keys < key (or <= key when inclusive is set).
+            size_type countLess(const key_type& key, bool inclusive) const {
+                node_type* current = m_root;
+                size_type count = 0;
+                while (current) {
+                    bool goRight = inclusive ? !m_comp(key, current->data.first)
+                                             : m_comp(current->data.first, key);
+                    if (goRight) {
+                        count += subtreeSize(current->left) + 1;
+                        current = current->right;
+                    }
+                    else {
+                        current = current->left;
+                    }
+                }
+                return count;
+            }
+
+            node_type* nthNode(size_type k) const {
+                node_type* current = m_root;
+                while (current) {
+                    size_type leftSize = subtreeSize(current->left);
+                    if (k < leftSize) {
+                        current = current->left;
+                    }
+                    else if (k == leftSize) {
+                        return current;
+                    }
+                    else {
+                        k -= leftSize + 1;
+                        current = current->right;
+                    }
+                }
+                return nullptr;
+            }
+
+            node_type* findNode(const key_type& key) const {
                 node_type* current = m_root;
                 while (current) {
                     if (m_comp(key, current->data.first)) {
@@ -476,6 +835,12 @@ namespace container
     public:
         explicit Map(NodeAllocator allocator = NodeAllocator())
             : tree_type(allocator) {}
+
+        template <std::input_iterator InputIt>
+        Map(InputIt first, InputIt last, NodeAllocator allocator = NodeAllocator())
+            : tree_type(allocator) {
+            this->build(first, last);
+        }
     };
 
 } // namespace container
@@ -0,0 +1,261 @@
+#ifndef CONTAINER_MAP_IO_HPP
+#define CONTAINER_MAP_IO_HPP
+
+#include "Map.hpp"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// On-disk layout (native byte order, every section 8-byte aligned):
+//
+//   MapFileHeader
+//   keys     count * sizeof(Key), in key order
+//   values   fixed-size values: count * sizeof(Value)
+//            variable-size values: (count + 1) uint64 offsets into the blob, then the blob itself
+//
+// Because keys are stored sorted, a mapped file can be binary-searched in place, and loading it back
+// into a Map is a linear bulk build.
+
+namespace container
+{
+    namespace detail
+    {
+        struct MapFileHeader {
+            char magic[4];
+            std::uint32_t version;
+            std::uint32_t keySize;
+            std::uint32_t valueSize; // 0 for variable-size values
+            std::uint64_t count;
+            std::uint64_t keysOffset;
+            std::uint64_t valuesOffset;
+            std::uint64_t blobOffset; // 0 for fixed-size values
+            std::uint64_t fileSize;
+        };
+
+        inline constexpr char map_file_magic[4] = { 'C', 'M', 'A', 'P' };
+        inline constexpr std::uint32_t map_file_version = 1;
+
+        inline std::uint64_t alignUp(std::uint64_t offset) {
+            return (offset + 7) & ~std::uint64_t(7);
+        }
+
+        // Whether count items of itemSize bytes starting at offset end within size, without overflowing.
+        inline bool fits(std::uint64_t offset, std::uint64_t count, std::uint64_t itemSize, std::uint64_t size) {
+            return offset <= size && count <= (size - offset) / itemSize;
+        }
+
+        // How a value type is laid out on disk. Trivially copyable values are stored inline;
+        // std::string goes to the blob and reads back as a string_view into the mapping.
+        template <typename T>
+        struct MapCodec {
+            static_assert(std::is_trivially_copyable_v<T>, "container::MapCodec: unsupported value type");
+            static constexpr bool fixed = true;
+            using view_type = T;
+
+            static view_type read(const char* data) {
+                T value;
+                std::memcpy(&value, data, sizeof(T));
+                return value;
+            }
+        };
+
+        template <>
+        struct MapCodec<std::string> {
+            static constexpr bool fixed = false;
+            using view_type = std::string_view;
+
+            static std::string_view bytes(const std::string& value) { return value; }
+        };
+    } // namespace detail
+
+
+    // Writes the map to path in key order. Throws std::runtime_error on I/O failure.
+    template <typename Key, typename Value, typename Compare, typename Allocator>
+    void save(const Map<Key, Value, Compare, Allocator>& map, const std::string& path) {
+        static_assert(std::is_trivially_copyable_v<Key>, "container::save: keys must be trivially copyable");
+        using codec = detail::MapCodec<Value>;
+
+        // One in-order walk; the section writers below then read the elements sequentially.
+        std::vector<const std::pair<Key, Value>*> items;
+        items.reserve(map.size());
+        for (const auto& item : map) items.push_back(&item);
+
+        detail::MapFileHeader header{};
+        std::memcpy(header.magic, detail::map_file_magic, sizeof(header.magic));
+        header.version = detail::map_file_version;
+        header.keySize = sizeof(Key);
+        header.valueSize = codec::fixed ? sizeof(Value) : 0;
+        header.count = map.size();
+        header.keysOffset = detail::alignUp(sizeof(header));
+        header.valuesOffset = detail::alignUp(header.keysOffset + header.count * sizeof(Key));
+        if constexpr (codec::fixed) {
+            header.fileSize = header.valuesOffset + header.count * sizeof(Value);
+        }
+        else {
+            header.blobOffset = header.valuesOffset + (header.count + 1) * sizeof(std::uint64_t);
+            std::uint64_t blobSize = 0;
+            for (const auto* item : items) blobSize += codec::bytes(item->second).size();
+            header.fileSize = header.blobOffset + blobSize;
+        }
+
+        std::vector<char> buffer(1 << 20);
+        std::ofstream out;
+        out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("container::save: cannot open " + path);
+
+        const char padding[8] = {};
+        auto padTo = [&](std::uint64_t offset) {
+            auto position = static_cast<std::uint64_t>(out.tellp());
+            out.write(padding, static_cast<std::streamsize>(offset - position));
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        padTo(header.keysOffset);
+        for (const auto* item : items) out.write(reinterpret_cast<const char*>(&item->first), sizeof(Key));
+        padTo(header.valuesOffset);
+        if constexpr (codec::fixed) {
+            for (const auto* item : items) out.write(reinterpret_cast<const char*>(&item->second), sizeof(Value));
+        }
+        else {
+            std::uint64_t offset = 0;
+            out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+            for (const auto* item : items) {
+                offset += codec::bytes(item->second).size();
+                out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+            }
+            for (const auto* item : items) {
+                std::string_view bytes = codec::bytes(item->second);
+                out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            }
+        }
+        if (!out.flush()) throw std::runtime_error("container::save: write failed for " + path);
+    }
+
+
+    // Read-only view of a file written by save(). Lookups binary-search the mapped key array directly;
+    // nothing is deserialized up front, and pages are faulted in as they are touched. Opening checks the
+    // header against the file size, which for string values means one pass over the offset table.
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class MappedMap {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+        using view_type = typename detail::MapCodec<Value>::view_type;
+
+        explicit MappedMap(const std::string& path) : m_file(path) {
+            if (m_file.size() < sizeof(detail::MapFileHeader))
+                throw std::runtime_error("container::MappedMap: truncated file " + path);
+            std::memcpy(&m_header, m_file.data(), sizeof(m_header));
+            if (std::memcmp(m_header.magic, detail::map_file_magic, sizeof(m_header.magic)) != 0 ||
+                m_header.version != detail::map_file_version)
+                throw std::runtime_error("container::MappedMap: not a map file " + path);
+            if (m_header.keySize != sizeof(Key) ||
+                m_header.valueSize != (codec::fixed ? sizeof(Value) : 0))
+                throw std::runtime_error("container::MappedMap: type mismatch in " + path);
+            if (m_header.fileSize != m_file.size())
+                throw std::runtime_error("container::MappedMap: truncated file " + path);
+            if (!validLayout())
+                throw std::runtime_error("container::MappedMap: corrupt file " + path);
+            m_keys = reinterpret_cast<const Key*>(m_file.data() + m_header.keysOffset);
+        }
+
+        [[nodiscard]] size_type size() const noexcept { return static_cast<size_type>(m_header.count); }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        // i-th smallest key and its value.
+        const Key& key(size_type i) const { return m_keys[i]; }
+
+        view_type value(size_type i) const {
+            const char* values = m_file.data() + m_header.valuesOffset;
+            if constexpr (codec::fixed) {
+                return codec::read(values + i * sizeof(Value));
+            }
+            else {
+                std::uint64_t begin, end;
+                std::memcpy(&begin, values + i * sizeof(std::uint64_t), sizeof(begin));
+                std::memcpy(&end, values + (i + 1) * sizeof(std::uint64_t), sizeof(end));
+                return view_type(m_file.data() + m_header.blobOffset + begin, static_cast<size_type>(end - begin));
+            }
+        }
+
+        // Index of the first key not less than key, size() if there is none.
+        size_type lower_bound(const key_type& key) const {
+            return static_cast<size_type>(std::lower_bound(m_keys, m_keys + size(), key, m_comp) - m_keys);
+        }
+
+        std::optional<view_type> find(const key_type& key) const {
+            size_type i = lower_bound(key);
+            if (i == size() || m_comp(key, m_keys[i])) return std::nullopt;
+            return value(i);
+        }
+
+        bool contains(const key_type& key) const { return find(key).has_value(); }
+
+        // Materializes the file into a live map in O(n), using the stored key order.
+        template <typename Allocator = std::allocator<std::pair<Key, Value>>>
+        Map<Key, Value, Compare, Allocator> toMap() const {
+            std::vector<std::pair<Key, Value>> values;
+            values.reserve(size());
+            for (size_type i = 0; i < size(); ++i) values.emplace_back(m_keys[i], Value(value(i)));
+            Map<Key, Value, Compare, Allocator> map;
+            map.build(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+            return map;
+        }
+
+    private:
+        using codec = detail::MapCodec<Value>;
+
+        io::MappedFile m_file;
+        detail::MapFileHeader m_header{};
+
+        // Every section aligned and inside the file, and for variable-size values an offset table that
+        // never decreases and stays inside the blob -- so no lookup can read outside the mapping.
+        bool validLayout() const {
+            const detail::MapFileHeader& h = m_header;
+            std::uint64_t size = m_file.size();
+            if (h.keysOffset % 8 || h.valuesOffset % 8 || h.blobOffset % 8) return false;
+            if (h.keysOffset < sizeof(detail::MapFileHeader) || !detail::fits(h.keysOffset, h.count, sizeof(Key), size))
+                return false;
+            if (h.valuesOffset < h.keysOffset + h.count * sizeof(Key)) return false;
+            if constexpr (codec::fixed) {
+                return h.blobOffset == 0 && detail::fits(h.valuesOffset, h.count, sizeof(Value), size);
+            }
+            else {
+                if (h.count == UINT64_MAX || !detail::fits(h.valuesOffset, h.count + 1, sizeof(std::uint64_t), size))
+                    return false;
+                if (h.blobOffset < h.valuesOffset + (h.count + 1) * sizeof(std::uint64_t) || h.blobOffset > size)
+                    return false;
+                std::uint64_t previous = 0;
+                for (std::uint64_t i = 0; i <= h.count; ++i) {
+                    std::uint64_t offset;
+                    std::memcpy(&offset, m_file.data() + h.valuesOffset + i * sizeof(offset), sizeof(offset));
+                    if (offset < previous || (i == 0 && offset != 0)) return false;
+                    previous = offset;
+                }
+                return previous <= size - h.blobOffset;
+            }
+        }
+        const Key* m_keys = nullptr;
+        Compare m_comp;
+    };
+
+
+    // Reads a file written by save() back into a live map.
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    Map<Key, Value, Compare> load(const std::string& path) {
+        return MappedMap<Key, Value, Compare>(path).toMap();
+    }
+
+} // namespace container
+
+#endif // CONTAINER_MAP_IO_HPP
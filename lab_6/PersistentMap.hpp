@@ -0,0 +1,381 @@
+#ifndef CONTAINER_PERSISTENT_MAP_HPP
+#define CONTAINER_PERSISTENT_MAP_HPP
+
+#include "Map.hpp"
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace container
+{
+    namespace detail
+    {
+        // Node shared between versions. It is never modified after construction; the reference count
+        // tracks how many parents and version roots point at it.
+        template <typename Key, typename Value>
+        struct CountedNode {
+            using value_type = std::pair<Key, Value>;
+            value_type data;
+            const CountedNode* left;
+            const CountedNode* right;
+            int height;
+            mutable std::atomic<std::size_t> refs;
+
+            CountedNode(const value_type& val, const CountedNode* l, const CountedNode* r)
+                : data(val), left(l), right(r),
+                  height(1 + std::max(l ? l->height : 0, r ? r->height : 0)), refs(1) {}
+        };
+    } // namespace detail
+
+
+    // Persistent (immutable) AVL map. insert() and remove() leave the map untouched and return a new
+    // version that shares every subtree off the modified path, so each update allocates O(log n) nodes
+    // and copying a version -- a snapshot -- is O(1). Nodes are freed when the last version using them
+    // goes away. Distinct versions may be used from different threads.
+    template <detail::Tree_type Key, detail::Tree_type Value,
+        typename Compare = std::less<Key>,
+        typename Allocator = std::allocator<std::pair<Key, Value>>>
+    class PersistentMap {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using key_compare = Compare;
+        using node_type = detail::CountedNode<Key, Value>;
+        using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+        using allocator_type = NodeAllocator;
+
+        explicit PersistentMap(NodeAllocator allocator = NodeAllocator())
+            : m_alloc(allocator) {}
+
+        // Builds the first version from [first, last). Input sorted by key is linked into a balanced
+        // tree in O(n); anything else is inserted element by element. The first duplicate wins.
+        template <std::input_iterator InputIt>
+        PersistentMap(InputIt first, InputIt last, NodeAllocator allocator = NodeAllocator())
+            : m_alloc(allocator) {
+            std::vector<value_type> values(first, last);
+            auto keyLess = [this](const value_type& a, const value_type& b) { return m_comp(a.first, b.first); };
+            if (!std::is_sorted(values.begin(), values.end(), keyLess)) {
+                for (const auto& val : values) *this = insert(val);
+                return;
+            }
+            auto keyEqual = [this](const value_type& a, const value_type& b) {
+                return !m_comp(a.first, b.first) && !m_comp(b.first, a.first);
+            };
+            values.erase(std::unique(values.begin(), values.end(), keyEqual), values.end());
+            m_root = link(values, 0, values.size());
+            m_size = values.size();
+        }
+
+        PersistentMap(const PersistentMap& other) noexcept
+            : m_root(acquire(other.m_root)), m_size(other.m_size), m_comp(other.m_comp), m_alloc(other.m_alloc) {}
+
+        PersistentMap(PersistentMap&& other) noexcept
+            : m_root(std::exchange(other.m_root, nullptr)), m_size(std::exchange(other.m_size, 0)),
+              m_comp(std::move(other.m_comp)), m_alloc(std::move(other.m_alloc)) {}
+
+        PersistentMap& operator=(PersistentMap other) noexcept {
+            std::swap(m_root, other.m_root);
+            std::swap(m_size, other.m_size);
+            std::swap(m_comp, other.m_comp);
+            std::swap(m_alloc, other.m_alloc);
+            return *this;
+        }
+
+        ~PersistentMap() { release(m_root); }
+
+        [[nodiscard]] allocator_type get_allocator() const {
+            return m_alloc;
+        }
+
+        // Point-in-time copy of this version, O(1).
+        [[nodiscard]] PersistentMap snapshot() const { return *this; }
+
+        // Element Access
+        const mapped_type& at(const key_type& key) const {
+            const node_type* node = findNode(key);
+            if (!node) {
+                throw std::out_of_range("container::PersistentMap::at");
+            }
+            return node->data.second;
+        }
+
+        // Pointer to the value stored for key, or nullptr. Valid as long as this version lives.
+        const mapped_type* find(const key_type& key) const {
+            const node_type* node = findNode(key);
+            return node ? &node->data.second : nullptr;
+        }
+
+        bool contains(const key_type& key) const { return findNode(key) != nullptr; }
+
+        // Calls fn(key, value) for every element in key order.
+        template <typename Fn>
+        void for_each(Fn&& fn) const {
+            std::vector<const node_type*> stack;
+            const node_type* current = m_root;
+            while (current || !stack.empty()) {
+                while (current) {
+                    stack.push_back(current);
+                    current = current->left;
+                }
+                current = stack.back();
+                stack.pop_back();
+                fn(current->data.first, current->data.second);
+                current = current->right;
+            }
+        }
+
+        // New versions
+
+        // The key's existing value is kept, as in Map::insert.
+        [[nodiscard]] PersistentMap insert(const value_type& val) const {
+            bool added = false;
+            const node_type* root = insertUtil(m_root, val, false, added);
+            return derive(root, added ? m_size + 1 : m_size);
+        }
+
+        [[nodiscard]] PersistentMap insert_or_assign(const value_type& val) const {
+            bool added = false;
+            const node_type* root = insertUtil(m_root, val, true, added);
+            return derive(root, added ? m_size + 1 : m_size);
+        }
+
+        [[nodiscard]] PersistentMap remove(const key_type& key) const {
+            bool removed = false;
+            const node_type* root = removeUtil(m_root, key, removed);
+            return derive(root, removed ? m_size - 1 : m_size);
+        }
+
+        // Capacity
+        [[nodiscard]] size_type size() const noexcept { return m_size; }
+
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+        void inorder() const {
+            for_each([](const key_type& key, const mapped_type& value) {
+                std::cout << key << ": " << value << std::endl;
+            });
+            std::cout << std::endl;
+        }
+
+    private:
+        const node_type* m_root = nullptr;
+        size_type m_size{};
+        Compare m_comp;
+        mutable NodeAllocator m_alloc;
+
+        // Every helper below returns a node the caller owns one reference to, and makeNode/balanced
+        // take over the references passed to them.
+
+        PersistentMap derive(const node_type* root, size_type size) const {
+            PersistentMap version(m_alloc);
+            version.m_comp = m_comp;
+            version.m_root = root;
+            version.m_size = size;
+            return version;
+        }
+
+        static const node_type* acquire(const node_type* node) {
+            if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+            return node;
+        }
+
+        void release(const node_type* node) const {
+            // Iterative, so dropping a long-lived chain of versions cannot overflow the stack.
+            std::vector<const node_type*> pending;
+            while (node || !pending.empty()) {
+                if (!node) {
+                    node = pending.back();
+                    pending.pop_back();
+                }
+                if (node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    node = nullptr;
+                    continue;
+                }
+                const node_type* left = node->left;
+                const node_type* right = node->right;
+                node_type* dead = const_cast<node_type*>(node);
+                std::allocator_traits<NodeAllocator>::destroy(m_alloc, dead);
+                std::allocator_traits<NodeAllocator>::deallocate(m_alloc, dead, 1);
+                if (right) pending.push_back(right);
+                node = left;
+            }
+        }
+
+        // On failure the node is freed and the references passed in are released before rethrowing.
+        const node_type* makeNode(const value_type& val, const node_type* l, const node_type* r) const {
+            node_type* node = nullptr;
+            try {
+                node = std::allocator_traits<NodeAllocator>::allocate(m_alloc, 1);
+                std::allocator_traits<NodeAllocator>::construct(m_alloc, node, val, l, r);
+            }
+            catch (...) {
+                if (node) std::allocator_traits<NodeAllocator>::deallocate(m_alloc, node, 1);
+                release(l);
+                release(r);
+                throw;
+            }
+            return node;
+        }
+
+        static int height(const node_type* head) {
+            return head ? head->height : 0;
+        }
+
+        // Rotations build their new nodes one at a time, handing each reference on as soon as a node owns
+        // it, so whatever throws, everything l and r referred to is released exactly once.
+        const node_type* balanced(const value_type& data, const node_type* l, const node_type* r) const {
+            int bal = height(l) - height(r);
+            if (bal > 1) {
+                try {
+                    const node_type* result;
+                    if (height(l->left) >= height(l->right)) {
+                        const node_type* right = makeNode(data, acquire(l->right), std::exchange(r, nullptr));
+                        result = makeNode(l->data, acquire(l->left), right);
+                    }
+                    else {
+                        const node_type* lr = l->right;
+                        const node_type* left = makeNode(l->data, acquire(l->left), acquire(lr->left));
+                        const node_type* right;
+                        try {
+                            right = makeNode(data, acquire(lr->right), std::exchange(r, nullptr));
+                        }
+                        catch (...) {
+                            release(left);
+                            throw;
+                        }
+                        result = makeNode(lr->data, left, right);
+                    }
+                    release(l);
+                    return result;
+                }
+                catch (...) {
+                    release(l);
+                    release(r);
+                    throw;
+                }
+            }
+            if (bal < -1) {
+                try {
+                    const node_type* result;
+                    if (height(r->right) >= height(r->left)) {
+                        const node_type* left = makeNode(data, std::exchange(l, nullptr), acquire(r->left));
+                        result = makeNode(r->data, left, acquire(r->right));
+                    }
+                    else {
+                        const node_type* rl = r->left;
+                        const node_type* left = makeNode(data, std::exchange(l, nullptr), acquire(rl->left));
+                        const node_type* right;
+                        try {
+                            right = makeNode(r->data, acquire(rl->right), acquire(r->right));
+                        }
+                        catch (...) {
+                            release(left);
+                            throw;
+                        }
+                        result = makeNode(rl->data, left, right);
+                    }
+                    release(r);
+                    return result;
+                }
+                catch (...) {
+                    release(l);
+                    release(r);
+                    throw;
+                }
+            }
+            return makeNode(data, l, r);
+        }
+
+        const node_type* insertUtil(const node_type* head, const value_type& val, bool assign, bool& added) const {
+            if (!head) {
+                added = true;
+                return makeNode(val, nullptr, nullptr);
+            }
+            if (m_comp(val.first, head->data.first)) {
+                const node_type* sub = insertUtil(head->left, val, assign, added);
+                if (sub == head->left) {
+                    release(sub);
+                    return acquire(head);
+                }
+                return balanced(head->data, sub, acquire(head->right));
+            }
+            if (m_comp(head->data.first, val.first)) {
+                const node_type* sub = insertUtil(head->right, val, assign, added);
+                if (sub == head->right) {
+                    release(sub);
+                    return acquire(head);
+                }
+                return balanced(head->data, acquire(head->left), sub);
+            }
+            if (!assign) return acquire(head);
+            return makeNode(val, acquire(head->left), acquire(head->right));
+        }
+
+        // Copies the path to the smallest node of a non-empty subtree, leaving that node out.
+        const node_type* removeMin(const node_type* head, const value_type*& min) const {
+            if (!head->left) {
+                min = &head->data;
+                return acquire(head->right);
+            }
+            const node_type* left = removeMin(head->left, min);
+            return balanced(head->data, left, acquire(head->right));
+        }
+
+        const node_type* removeUtil(const node_type* head, const key_type& key, bool& removed) const {
+            if (!head) return nullptr;
+            if (m_comp(key, head->data.first)) {
+                const node_type* sub = removeUtil(head->left, key, removed);
+                if (!removed) {
+                    release(sub);
+                    return acquire(head);
+                }
+                return balanced(head->data, sub, acquire(head->right));
+            }
+            if (m_comp(head->data.first, key)) {
+                const node_type* sub = removeUtil(head->right, key, removed);
+                if (!removed) {
+                    release(sub);
+                    return acquire(head);
+                }
+                return balanced(head->data, acquire(head->left), sub);
+            }
+            removed = true;
+            if (!head->left) return acquire(head->right);
+            if (!head->right) return acquire(head->left);
+            const value_type* min = nullptr;
+            const node_type* right = removeMin(head->right, min);
+            return balanced(*min, acquire(head->left), right);
+        }
+
+        const node_type* link(const std::vector<value_type>& values, size_type lo, size_type hi) const {
+            if (lo == hi) return nullptr;
+            size_type mid = lo + (hi - lo) / 2;
+            const node_type* left = link(values, lo, mid);
+            const node_type* right;
+            try {
+                right = link(values, mid + 1, hi);
+            }
+            catch (...) {
+                release(left);
+                throw;
+            }
+            return makeNode(values[mid], left, right);
+        }
+
+        const node_type* findNode(const key_type& key) const {
+            const node_type* current = m_root;
+            while (current) {
+                if (m_comp(key, current->data.first)) current = current->left;
+                else if (m_comp(current->data.first, key)) current = current->right;
+                else return current;
+            }
+            return nullptr;
+        }
+    };
+
+} // namespace container
+
+#endif // CONTAINER_PERSISTENT_MAP_HPP
@@ -0,0 +1,69 @@
+#include "../Map.hpp"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Compares bulk construction and bulk merge against one-by-one insert().
+// Usage: Lab6BulkBench [elements] [batch]
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    std::size_t m = bench::argOr(argc, argv, 2, n / 2);
+
+    std::vector<std::pair<int, int>> sorted(n);
+    for (std::size_t i = 0; i < n; ++i)
+        sorted[i] = { static_cast<int>(i * 2), static_cast<int>(i) };
+
+    std::vector<std::pair<int, int>> shuffled = sorted;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+
+    std::cout << "elements: " << n << ", merge batch: " << m << std::endl;
+
+    {
+        container::Map<int, int> map;
+        double t = bench::measure([&] { map.build(sorted.begin(), sorted.end()); });
+        bench::report("build() sorted", t, n);
+    }
+    {
+        container::Map<int, int> map;
+        double t = bench::measure([&] { map.build(shuffled.begin(), shuffled.end()); });
+        bench::report("build() shuffled", t, n);
+    }
+
+    {
+        container::Map<int, int> map;
+        double t = bench::measure([&] { for (const auto& el : sorted) map.insert(el); });
+        bench::report("insert() sorted", t, n);
+    }
+    {
+        container::Map<int, int> map;
+        double t = bench::measure([&] { for (const auto& el : shuffled) map.insert(el); });
+        bench::report("insert() shuffled", t, n);
+    }
+    // Odd keys interleave with the even keys already in the map.
+    std::vector<std::pair<int, int>> batch(m);
+    for (std::size_t i = 0; i < m; ++i)
+        batch[i] = { static_cast<int>(i * 2 + 1), static_cast<int>(i) };
+
+    std::size_t insertSize = 0, mergeSize = 0;
+    {
+        container::Map<int, int> map(sorted.begin(), sorted.end());
+        double t = bench::measure([&] { for (const auto& el : batch) map.insert(el); });
+        bench::report("insert() batch into map", t, m);
+        insertSize = map.size();
+    }
+    {
+        container::Map<int, int> map(sorted.begin(), sorted.end());
+        double t = bench::measure([&] { map.merge_sorted(batch.begin(), batch.end()); });
+        bench::report("merge_sorted() batch into map", t, m);
+        mergeSize = map.size();
+    }
+
+    if (insertSize != mergeSize) {
+        std::cerr << "mismatch: insert " << insertSize << ", merge " << mergeSize << std::endl;
+        return 1;
+    }
+    return 0;
+}
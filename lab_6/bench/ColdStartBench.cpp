@@ -0,0 +1,68 @@
+#include "../MapIO.hpp"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+// Startup cost of a passport map: re-inserting every pair, bulk-loading the saved file,
+// and opening the file memory-mapped.
+// Usage: Lab6ColdStartBench [elements] [lookups]
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 10'000'000);
+    std::size_t lookups = bench::argOr(argc, argv, 2, 100'000);
+    std::string path = (std::filesystem::temp_directory_path() / "lab6_passports.cmap").string();
+
+    std::vector<std::pair<int, std::string>> records(n);
+    for (std::size_t i = 0; i < n; ++i)
+        records[i] = { static_cast<int>(i * 3), "Passport holder " + std::to_string(i) };
+    std::shuffle(records.begin(), records.end(), std::mt19937(42));
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> keyDist(0, static_cast<int>(n) * 3);
+    std::vector<int> keys(lookups);
+    for (auto& key : keys) key = keyDist(gen);
+
+    std::cout << "elements: " << n << ", lookups: " << lookups << std::endl;
+
+    std::size_t hits[3] = {};
+    {
+        container::Map<int, std::string> map;
+        double t = bench::measure([&] { for (const auto& el : records) map.insert(el); });
+        bench::report("insert() every pair", t, n);
+
+        double s = bench::measure([&] { container::save(map, path); });
+        bench::report("save()", s, n);
+        std::cout << "  file size: " << std::filesystem::file_size(path) / (1024 * 1024) << " MiB" << std::endl;
+
+        for (int key : keys) hits[0] += map.find(key) != map.end();
+    }
+    {
+        container::Map<int, std::string> map;
+        double t = bench::measure([&] { map = container::load<int, std::string>(path); });
+        bench::report("load() into Map", t, n);
+        for (int key : keys) hits[1] += map.find(key) != map.end();
+    }
+    {
+        std::size_t found = 0;
+        double t = bench::measure([&] {
+            container::MappedMap<int, std::string> mapped(path);
+            for (int key : keys) {
+                auto value = mapped.find(key);
+                if (value) found += value->size() != 0;
+            }
+        });
+        bench::report("MappedMap open + lookups", t, lookups);
+        hits[2] = found;
+    }
+    std::remove(path.c_str());
+
+    if (hits[0] != hits[1] || hits[0] != hits[2]) {
+        std::cerr << "mismatch: map " << hits[0] << ", loaded " << hits[1] << ", mapped " << hits[2] << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "../ConcurrentMap.hpp"
+#include "BenchUtils.h"
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Read/write mixes against a Map behind one global mutex and against ConcurrentMap.
+// Usage: Lab6ConcurrentBench [elements] [ops per thread] [max threads]
+namespace
+{
+    struct LockedMap {
+        container::Map<int, int> map;
+        std::mutex mutex;
+
+        bool find(int key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return map.find(key) != map.end();
+        }
+        void insert(int key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            map.insert({ key, key });
+        }
+        void remove(int key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            map.remove(key);
+        }
+    };
+
+    struct SharedMap {
+        container::ConcurrentMap<int, int> map;
+
+        bool find(int key) { return map.contains(key); }
+        void insert(int key) { map.insert({ key, key }); }
+        void remove(int key) { map.remove(key); }
+    };
+
+    template <typename MapType>
+    double run(MapType& m, int keyRange, std::size_t ops, unsigned threads, unsigned readPercent)
+    {
+        std::vector<std::thread> workers;
+        return bench::measure([&] {
+            for (unsigned t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    std::mt19937 gen(t + 1);
+                    std::uniform_int_distribution<int> keyDist(0, keyRange - 1);
+                    std::uniform_int_distribution<unsigned> opDist(0, 99);
+                    std::size_t hits = 0;
+                    for (std::size_t i = 0; i < ops; ++i) {
+                        int key = keyDist(gen);
+                        unsigned op = opDist(gen);
+                        if (op < readPercent) hits += m.find(key);
+                        else if (op % 2) m.insert(key);
+                        else m.remove(key);
+                    }
+                    bench::doNotOptimize(hits);
+                });
+            }
+            for (auto& w : workers) w.join();
+        });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    std::size_t ops = bench::argOr(argc, argv, 2, 200'000);
+    unsigned maxThreads = static_cast<unsigned>(bench::argOr(argc, argv, 3, 32));
+    int keyRange = static_cast<int>(n * 2);
+
+    std::vector<std::pair<int, int>> initial;
+    for (int key = 0; key < keyRange; key += 2) initial.push_back({ key, key });
+
+    std::cout << "elements: " << n << ", ops per thread: " << ops
+              << ", hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (unsigned readPercent : { 99u, 90u, 50u }) {
+        std::cout << "\n" << readPercent << "% reads / " << 100 - readPercent << "% writes" << std::endl;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            LockedMap locked;
+            locked.map.build(initial.begin(), initial.end());
+            SharedMap shared;
+            for (const auto& el : initial) shared.map.insert(el);
+
+            double tLocked = run(locked, keyRange, ops, threads, readPercent);
+            double tShared = run(shared, keyRange, ops, threads, readPercent);
+            bench::report("mutex Map, " + std::to_string(threads) + " threads", tLocked, ops * threads);
+            bench::report("ConcurrentMap, " + std::to_string(threads) + " threads", tShared, ops * threads);
+        }
+    }
+    return 0;
+}
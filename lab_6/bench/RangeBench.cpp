@@ -0,0 +1,72 @@
+#include "../Map.hpp"
+#include "BenchUtils.h"
+#include <random>
+#include <vector>
+
+// Compares ordered-map range queries against a full in-order scan.
+// Usage: Lab6RangeBench [elements] [queries]
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    std::size_t q = bench::argOr(argc, argv, 2, 50);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> keyDist(0, static_cast<int>(n) * 4);
+
+    container::Map<int, int> m;
+    for (std::size_t i = 0; i < n; ++i) {
+        int key = keyDist(gen);
+        m.insert({ key, key });
+    }
+
+    std::vector<std::pair<int, int>> queries(q);
+    for (auto& [lo, hi] : queries) {
+        lo = keyDist(gen);
+        hi = lo + static_cast<int>(n / 100);
+    }
+
+    std::cout << "elements: " << m.size() << ", queries: " << q << std::endl;
+
+    std::size_t scanTotal = 0;
+    double scan = bench::measure([&] {
+        for (auto [lo, hi] : queries)
+            for (auto it = m.begin(); it != m.end(); ++it)
+                if (it->first >= lo && it->first <= hi) ++scanTotal;
+    });
+    bench::report("linear scan", scan, q);
+
+    std::size_t iterTotal = 0;
+    double iter = bench::measure([&] {
+        for (auto [lo, hi] : queries)
+            for (auto& el : m.range(lo, hi)) {
+                bench::doNotOptimize(el);
+                ++iterTotal;
+            }
+    });
+    bench::report("range() iteration", iter, q);
+
+    std::size_t countTotal = 0;
+    double count = bench::measure([&] {
+        for (auto [lo, hi] : queries)
+            countTotal += m.count_range(lo, hi);
+    });
+    bench::report("count_range()", count, q);
+
+    std::size_t nthTotal = 0;
+    double nth = bench::measure([&] {
+        for (std::size_t i = 0; i < q; ++i) {
+            auto it = m.nth(i * (m.size() / q));
+            nthTotal += it->first;
+            nthTotal += m.rank(it->first);
+        }
+    });
+    bench::report("nth() + rank()", nth, q);
+    bench::doNotOptimize(nthTotal);
+
+    if (scanTotal != iterTotal || scanTotal != countTotal) {
+        std::cerr << "mismatch: scan " << scanTotal << ", range " << iterTotal
+                  << ", count " << countTotal << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "../PersistentMap.hpp"
+#include "BenchUtils.h"
+#include <random>
+#include <vector>
+
+// Snapshot cost and memory of PersistentMap versions against deep copies of Map.
+// Usage: Lab6SnapshotBench [elements] [versions] [updates per version]
+namespace
+{
+    std::size_t g_liveBytes = 0;
+
+    // Tracks the bytes currently held by the containers under test.
+    template <typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            g_liveBytes += n * sizeof(T);
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            g_liveBytes -= n * sizeof(T);
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+    };
+
+    using Alloc = CountingAllocator<std::pair<int, int>>;
+    using TreeMap = container::Map<int, int, std::less<int>, Alloc>;
+    using VersionedMap = container::PersistentMap<int, int, std::less<int>, Alloc>;
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 100'000);
+    std::size_t versions = bench::argOr(argc, argv, 2, 20);
+    std::size_t updates = bench::argOr(argc, argv, 3, 100);
+
+    std::vector<std::pair<int, int>> initial(n);
+    for (std::size_t i = 0; i < n; ++i) initial[i] = { static_cast<int>(i), static_cast<int>(i) };
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> keyDist(0, static_cast<int>(n) - 1);
+    std::vector<int> keys(versions * updates);
+    for (auto& key : keys) key = keyDist(gen);
+
+    std::cout << "elements: " << n << ", versions: " << versions
+              << ", updates per version: " << updates << std::endl;
+
+    // Each version is a snapshot followed by `updates` overwrites on the live map.
+    {
+        TreeMap live(initial.begin(), initial.end());
+        std::size_t base = g_liveBytes;
+        std::vector<TreeMap> copies;
+        copies.reserve(versions);
+        double copyTime = 0;
+        for (std::size_t v = 0; v < versions; ++v) {
+            copyTime += bench::measure([&] { copies.push_back(live); });
+            for (std::size_t u = 0; u < updates; ++u) {
+                int key = keys[v * updates + u];
+                live.remove(key);
+                live.insert({ key, static_cast<int>(v) });
+            }
+        }
+        bench::report("Map deep copy", copyTime, versions);
+        std::cout << "  extra memory for " << versions << " versions: "
+                  << (g_liveBytes - base) / 1024 << " KiB" << std::endl;
+    }
+    {
+        VersionedMap live(initial.begin(), initial.end());
+        std::size_t base = g_liveBytes;
+        std::vector<VersionedMap> snapshots;
+        snapshots.reserve(versions);
+        double snapshotTime = 0;
+        double updateTime = 0;
+        for (std::size_t v = 0; v < versions; ++v) {
+            snapshotTime += bench::measure([&] { snapshots.push_back(live.snapshot()); });
+            updateTime += bench::measure([&] {
+                for (std::size_t u = 0; u < updates; ++u)
+                    live = live.insert_or_assign({ keys[v * updates + u], static_cast<int>(v) });
+            });
+        }
+        bench::report("PersistentMap snapshot", snapshotTime, versions);
+        bench::report("PersistentMap path-copying update", updateTime, versions * updates);
+        std::cout << "  extra memory for " << versions << " versions: "
+                  << (g_liveBytes - base) / 1024 << " KiB" << std::endl;
+    }
+    return 0;
+}
@@ -37,9 +37,7 @@ int main()
 
     container::Map<int, std::string> m;
 
-    for (auto el : passport_data) {
-        m.insert(el);
-    }
+    m.build(passport_data.begin(), passport_data.end());
 
     m.inorder();
     m.preorder();
@@ -0,0 +1,226 @@
+#ifndef CONCURRENT_HASH_TABLE_H
+#define CONCURRENT_HASH_TABLE_H
+
+#include "HashTable.h"
+#include "EpochDomain.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Flight table for many threads. Flights are spread over lock-striped shards, each a linear-probing
+// table whose keys and values are atomics.
+//
+// search() takes no lock: it announces itself in a reader slot, reads the shard's current table and
+// probes it, so it finishes in a bounded number of steps whatever the writers do. (Only when more than
+// readerSlots threads are searching at once does the overflow fall back to the shard lock.)
+//
+// insert() and erase() lock only their shard. A key owns its slot for the life of a table -- erase()
+// just clears the value -- so a reader can never see a slot change from one flight number to another.
+// When a shard's table fills up, the writer copies the live flights into a new table and publishes it;
+// the old one is freed once no reader that might still be probing it is active.
+class ConcurrentHashTable {
+public:
+    static constexpr std::size_t defaultShards = 64;
+    static constexpr std::size_t defaultShardCapacity = 16;
+    static constexpr double maxLoad = 0.75;
+    static constexpr std::size_t readerSlots = 128;
+
+    explicit ConcurrentHashTable(std::size_t shardCount = defaultShards, std::size_t shardCapacity = defaultShardCapacity)
+        : shardBits(log2Ceil(shardCount)), shards(new Shard[std::size_t(1) << shardBits]) {
+        for (std::size_t i = 0; i < shardTotal(); i++) {
+            shards[i].table.store(new Table(roundCapacity(shardCapacity)), std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    // Requires that no other thread is still using the table.
+    ~ConcurrentHashTable() {
+        for (std::size_t i = 0; i < shardTotal(); i++) {
+            for (auto& retired : shards[i].limbo) delete retired.table;
+            delete shards[i].table.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Inserts a flight, or replaces the stored flight with the same number.
+    void insert(Flight* flight) {
+        int key = flight->flightNumber;
+        std::uint64_t hash = MixHash::scramble(key);
+        Shard& shard = shardOf(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        std::size_t index = table->slotFor(key, hash);
+        if (table->keys[index].load(std::memory_order_relaxed) == key) {
+            if (!table->values[index].exchange(flight, std::memory_order_release)) shard.count++;
+            return;
+        }
+        if (table->used + 1 > maxLoad * table->capacity) {
+            table = rebuild(shard);
+            index = table->slotFor(key, hash);
+        }
+        // The value goes in first, so a reader that sees the key also sees its flight.
+        table->values[index].store(flight, std::memory_order_relaxed);
+        table->keys[index].store(key, std::memory_order_release);
+        table->used++;
+        shard.count++;
+    }
+
+    // Removes the flight with this number; returns false if there is none.
+    bool erase(int key) {
+        std::uint64_t hash = MixHash::scramble(key);
+        Shard& shard = shardOf(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        std::size_t index = table->slotFor(key, hash);
+        if (table->keys[index].load(std::memory_order_relaxed) != key) return false;
+        if (!table->values[index].exchange(nullptr, std::memory_order_release)) return false;
+        shard.count--;
+        return true;
+    }
+
+    Flight* search(int key) const {
+        std::uint64_t hash = MixHash::scramble(key);
+        Shard& shard = shardOf(hash);
+        reclaim::EpochDomain<readerSlots>::Guard guard(epochs);
+        if (!guard) {
+            // Every announcement slot is taken: read under the shard lock instead.
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            return shard.table.load(std::memory_order_relaxed)->find(key, hash);
+        }
+        return shard.table.load(std::memory_order_seq_cst)->find(key, hash);
+    }
+
+    // Exact when no writer is running.
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < shardTotal(); i++) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            total += shards[i].count;
+        }
+        return total;
+    }
+
+    std::size_t shardCount() const { return shardTotal(); }
+
+private:
+    using Key = std::int64_t;
+
+    // Flight numbers are ints, so this value can never be one.
+    static constexpr Key emptyKey = std::numeric_limits<Key>::min();
+
+    struct Table {
+        std::size_t capacity;
+        std::size_t used = 0; // slots owned by a key, live or erased; guarded by the shard lock
+        std::unique_ptr<std::atomic<Key>[]> keys;
+        std::unique_ptr<std::atomic<Flight*>[]> values;
+
+        explicit Table(std::size_t capacity)
+            : capacity(capacity), keys(new std::atomic<Key>[capacity]), values(new std::atomic<Flight*>[capacity]) {
+            for (std::size_t i = 0; i < capacity; i++) {
+                keys[i].store(emptyKey, std::memory_order_relaxed);
+                values[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        // The slot holding key, or the empty slot where it would go.
+        std::size_t slotFor(int key, std::uint64_t hash) const {
+            std::size_t mask = capacity - 1;
+            std::size_t index = hash & mask;
+            for (;;) {
+                Key k = keys[index].load(std::memory_order_relaxed);
+                if (k == key || k == emptyKey) return index;
+                index = (index + 1) & mask;
+            }
+        }
+
+        // Lock-free lookup: at most `capacity` probes.
+        Flight* find(int key, std::uint64_t hash) const {
+            std::size_t mask = capacity - 1;
+            std::size_t index = hash & mask;
+            for (std::size_t probes = 0; probes < capacity; probes++) {
+                Key k = keys[index].load(std::memory_order_acquire);
+                if (k == key) return values[index].load(std::memory_order_acquire);
+                if (k == emptyKey) return nullptr;
+                index = (index + 1) & mask;
+            }
+            return nullptr;
+        }
+    };
+
+    struct Retired {
+        std::uint64_t epoch;
+        Table* table;
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<Table*> table{ nullptr };
+        mutable std::mutex mutex;
+        std::size_t count = 0;      // live flights
+        std::vector<Retired> limbo; // replaced tables that readers may still be probing
+    };
+
+    std::size_t shardBits;
+    std::unique_ptr<Shard[]> shards;
+    mutable reclaim::EpochDomain<readerSlots> epochs;
+
+    std::size_t shardTotal() const { return std::size_t(1) << shardBits; }
+
+    // The top bits pick the shard, the bottom bits the slot within it.
+    Shard& shardOf(std::uint64_t hash) const {
+        return shards[shardBits ? hash >> (64 - shardBits) : 0];
+    }
+
+    // Copies the live flights into a table sized for twice as many and publishes it. Erased keys are
+    // dropped, so a shard that only churns stays the same size.
+    Table* rebuild(Shard& shard) {
+        Table* old = shard.table.load(std::memory_order_relaxed);
+        Table* table = new Table(roundCapacity(static_cast<std::size_t>(2 * (shard.count + 1) / maxLoad)));
+        for (std::size_t i = 0; i < old->capacity; i++) {
+            Flight* flight = old->values[i].load(std::memory_order_relaxed);
+            if (!flight) continue;
+            int key = static_cast<int>(old->keys[i].load(std::memory_order_relaxed));
+            std::size_t index = table->slotFor(key, MixHash::scramble(key));
+            table->keys[index].store(key, std::memory_order_relaxed);
+            table->values[index].store(flight, std::memory_order_relaxed);
+            table->used++;
+        }
+        shard.table.store(table, std::memory_order_seq_cst);
+        shard.limbo.push_back({ epochs.advance(), old });
+
+        std::uint64_t oldest = epochs.oldestActive();
+        auto keep = shard.limbo.begin();
+        for (auto it = shard.limbo.begin(); it != shard.limbo.end(); ++it) {
+            if (it->epoch < oldest) {
+                delete it->table;
+            }
+            else {
+                if (keep != it) *keep = *it;
+                ++keep;
+            }
+        }
+        shard.limbo.erase(keep, shard.limbo.end());
+        return table;
+    }
+
+    static std::size_t roundCapacity(std::size_t n) {
+        std::size_t capacity = 8;
+        while (capacity < n) capacity *= 2;
+        return capacity;
+    }
+
+    static std::size_t log2Ceil(std::size_t n) {
+        std::size_t bits = 0;
+        while ((std::size_t(1) << bits) < n) bits++;
+        return bits;
+    }
+};
+
+#endif // CONCURRENT_HASH_TABLE_H
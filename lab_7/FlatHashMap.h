@@ -0,0 +1,311 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FLAT_HASH_MAP_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASH_MAP_SSE2
+#endif
+
+// Open-addressing map in the style of a Swiss table.
+//
+// Keys and values live inline in one slot array. Next to it is an array of control bytes, one per slot:
+// Empty, Deleted, or -- for a full slot -- the low 7 bits of the key's hash. A lookup loads a whole
+// group of control bytes (16 with SSE2, 32 with AVX2, 8 in the portable build), compares them with the
+// hash tag in one instruction, and only touches the slots whose tag matched. Groups are probed
+// quadratically, and a group that contains an Empty byte ends the search.
+//
+// The capacity is a power of two and at least one group. The first group of control bytes is mirrored
+// after the last one, so a group can be loaded at any slot index without wrapping.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+    using ctrl_t = std::int8_t;
+
+    static constexpr ctrl_t Empty = -128;
+    static constexpr ctrl_t Deleted = -2;
+
+    struct Group {
+#if defined(FLAT_HASH_MAP_AVX2)
+        static constexpr std::size_t width = 32;
+        __m256i ctrl;
+
+        explicit Group(const ctrl_t* pos) : ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))) {}
+
+        std::uint32_t match(ctrl_t tag) const {
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(tag), ctrl)));
+        }
+
+        // Empty and Deleted are the only negative control bytes.
+        std::uint32_t matchFree() const { return static_cast<std::uint32_t>(_mm256_movemask_epi8(ctrl)); }
+#elif defined(FLAT_HASH_MAP_SSE2)
+        static constexpr std::size_t width = 16;
+        __m128i ctrl;
+
+        explicit Group(const ctrl_t* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+        std::uint32_t match(ctrl_t tag) const {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl)));
+        }
+
+        std::uint32_t matchFree() const { return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl)); }
+#else
+        static constexpr std::size_t width = 8;
+        ctrl_t ctrl[width];
+
+        explicit Group(const ctrl_t* pos) { std::memcpy(ctrl, pos, width); }
+
+        std::uint32_t match(ctrl_t tag) const {
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < width; i++) mask |= std::uint32_t(ctrl[i] == tag) << i;
+            return mask;
+        }
+
+        std::uint32_t matchFree() const {
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < width; i++) mask |= std::uint32_t(ctrl[i] < 0) << i;
+            return mask;
+        }
+#endif
+        std::uint32_t matchEmpty() const { return match(Empty); }
+    };
+
+    struct Slot {
+        Key key;
+        Value value;
+    };
+
+public:
+    static constexpr std::size_t groupWidth = Group::width;
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(std::size_t n) { reserve(n); }
+
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+    FlatHashMap(FlatHashMap&& other) noexcept
+        : ctrl(std::move(other.ctrl)), slots(std::exchange(other.slots, nullptr)), cap(std::exchange(other.cap, 0)),
+          count(std::exchange(other.count, 0)), growthLeft(std::exchange(other.growthLeft, 0)) {}
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        FlatHashMap old(std::move(*this));
+        ctrl = std::move(other.ctrl);
+        slots = std::exchange(other.slots, nullptr);
+        cap = std::exchange(other.cap, 0);
+        count = std::exchange(other.count, 0);
+        growthLeft = std::exchange(other.growthLeft, 0);
+        return *this;
+    }
+
+    ~FlatHashMap() { release(); }
+
+    // Inserts key -> value, or replaces the value stored for key. Returns true if the key was new.
+    bool insert(const Key& key, Value value) {
+        std::size_t hash = hashOf(key);
+        std::size_t index = findIndex(key, hash);
+        if (index != npos) {
+            slots[index].value = std::move(value);
+            return false;
+        }
+        index = findFree(hash);
+        if (growthLeft == 0 && ctrl[index] != Deleted) {
+            // A table that is mostly tombstones is rebuilt at the same size rather than doubled.
+            resize(count + 1 > maxLoad(cap) / 2 ? std::max(2 * cap, groupWidth) : cap);
+            index = findFree(hash);
+        }
+        if (ctrl[index] == Empty) --growthLeft;
+        setCtrl(index, tagOf(hash));
+        ::new (static_cast<void*>(slots + index)) Slot{ key, std::move(value) };
+        ++count;
+        return true;
+    }
+
+    Value* find(const Key& key) {
+        std::size_t index = findIndex(key, hashOf(key));
+        return index != npos ? &slots[index].value : nullptr;
+    }
+
+    const Value* find(const Key& key) const {
+        std::size_t index = findIndex(key, hashOf(key));
+        return index != npos ? &slots[index].value : nullptr;
+    }
+
+    bool contains(const Key& key) const { return findIndex(key, hashOf(key)) != npos; }
+
+    // Asks the CPU to start loading the first group and slot a lookup or insert of key will touch.
+    void prefetch(const Key& key) const {
+        if (!cap) return;
+        Probe probe(groupOf(hashOf(key)), cap);
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(ctrl.get() + probe.offset);
+        __builtin_prefetch(slots + probe.offset);
+#elif defined(FLAT_HASH_MAP_AVX2) || defined(FLAT_HASH_MAP_SSE2)
+        _mm_prefetch(reinterpret_cast<const char*>(ctrl.get() + probe.offset), _MM_HINT_T0);
+        _mm_prefetch(reinterpret_cast<const char*>(slots + probe.offset), _MM_HINT_T0);
+#endif
+    }
+
+    // Removes key; returns false if it was not present. The slot becomes a tombstone that a later
+    // insert can reuse.
+    bool erase(const Key& key) {
+        std::size_t index = findIndex(key, hashOf(key));
+        if (index == npos) return false;
+        slots[index].~Slot();
+        setCtrl(index, Deleted);
+        --count;
+        return true;
+    }
+
+    // Makes room for n elements without further rehashing.
+    void reserve(std::size_t n) {
+        std::size_t needed = groupWidth;
+        while (maxLoad(needed) < n) needed *= 2;
+        if (needed > cap) resize(needed);
+    }
+
+    void clear() {
+        destroySlots();
+        if (cap) std::memset(ctrl.get(), Empty, cap + groupWidth);
+        count = 0;
+        growthLeft = maxLoad(cap);
+    }
+
+    // Calls fn(key, value) for every element, in slot order.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (std::size_t i = 0; i < cap; i++) {
+            if (ctrl[i] >= 0) fn(slots[i].key, slots[i].value);
+        }
+    }
+
+    std::size_t size() const { return count; }
+
+    bool empty() const { return count == 0; }
+
+    std::size_t capacity() const { return cap; }
+
+    double loadFactor() const { return cap ? static_cast<double>(count) / cap : 0.0; }
+
+    // Heap memory held by the table: slots plus control bytes.
+    std::size_t bytes() const { return cap ? cap * (sizeof(Slot) + 1) + groupWidth : 0; }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    std::unique_ptr<ctrl_t[]> ctrl;
+    Slot* slots = nullptr;
+    std::size_t cap = 0;
+    std::size_t count = 0;
+    std::size_t growthLeft = 0; // Empty slots that may still be filled before the next rehash
+
+    // Walks groups at offsets h, h + w, h + 3w, h + 6w, ... (mod capacity), which reaches every group
+    // when the capacity is a power of two.
+    struct Probe {
+        std::size_t mask;
+        std::size_t offset;
+        std::size_t step = 0;
+
+        Probe(std::size_t hash, std::size_t capacity) : mask(capacity - 1), offset(hash & mask) {}
+
+        std::size_t slot(std::uint32_t bit) const { return (offset + bit) & mask; }
+
+        void next() {
+            step += groupWidth;
+            offset = (offset + step) & mask;
+        }
+    };
+
+    // At most 7/8 of the slots are filled, so every probe sequence meets an Empty byte.
+    static std::size_t maxLoad(std::size_t capacity) { return capacity - capacity / 8; }
+
+    static std::size_t hashOf(const Key& key) {
+        // std::hash is the identity for integers; scramble it so both the tag and the group index
+        // depend on every bit of the key.
+        std::uint64_t h = static_cast<std::uint64_t>(Hash{}(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    static ctrl_t tagOf(std::size_t hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    static std::size_t groupOf(std::size_t hash) { return hash >> 7; }
+
+    void setCtrl(std::size_t index, ctrl_t value) {
+        ctrl[index] = value;
+        if (index < groupWidth) ctrl[cap + index] = value;
+    }
+
+    std::size_t findIndex(const Key& key, std::size_t hash) const {
+        if (!cap) return npos;
+        ctrl_t tag = tagOf(hash);
+        for (Probe probe(groupOf(hash), cap);; probe.next()) {
+            Group group(ctrl.get() + probe.offset);
+            for (std::uint32_t match = group.match(tag); match; match &= match - 1) {
+                std::size_t index = probe.slot(static_cast<std::uint32_t>(std::countr_zero(match)));
+                if (slots[index].key == key) return index;
+            }
+            if (group.matchEmpty()) return npos;
+        }
+    }
+
+    // First Empty or Deleted slot on the key's probe sequence.
+    std::size_t findFree(std::size_t hash) {
+        if (!cap) resize(groupWidth);
+        for (Probe probe(groupOf(hash), cap);; probe.next()) {
+            if (std::uint32_t free = Group(ctrl.get() + probe.offset).matchFree())
+                return probe.slot(static_cast<std::uint32_t>(std::countr_zero(free)));
+        }
+    }
+
+    void resize(std::size_t newCapacity) {
+        std::unique_ptr<ctrl_t[]> oldCtrl = std::move(ctrl);
+        Slot* oldSlots = slots;
+        std::size_t oldCapacity = cap;
+
+        ctrl.reset(new ctrl_t[newCapacity + groupWidth]);
+        std::memset(ctrl.get(), Empty, newCapacity + groupWidth);
+        slots = std::allocator<Slot>().allocate(newCapacity);
+        cap = newCapacity;
+        growthLeft = maxLoad(newCapacity) - count;
+
+        for (std::size_t i = 0; i < oldCapacity; i++) {
+            if (oldCtrl[i] < 0) continue;
+            std::size_t hash = hashOf(oldSlots[i].key);
+            std::size_t index = findFree(hash);
+            setCtrl(index, tagOf(hash));
+            ::new (static_cast<void*>(slots + index)) Slot(std::move(oldSlots[i]));
+            oldSlots[i].~Slot();
+        }
+        if (oldSlots) std::allocator<Slot>().deallocate(oldSlots, oldCapacity);
+    }
+
+    void destroySlots() {
+        for (std::size_t i = 0; i < cap; i++) {
+            if (ctrl[i] >= 0) slots[i].~Slot();
+        }
+    }
+
+    void release() {
+        if (!slots) return;
+        destroySlots();
+        std::allocator<Slot>().deallocate(slots, cap);
+        slots = nullptr;
+    }
+};
+
+#endif // FLAT_HASH_MAP_H
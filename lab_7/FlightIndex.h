@@ -0,0 +1,124 @@
+#ifndef FLIGHT_INDEX_H
+#define FLIGHT_INDEX_H
+
+#include "FlatHashMap.h"
+#include "FlightTable.h"
+#include "HashTable.h"
+
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// HashTable with two secondary indexes kept in step with it, for the questions a flight number cannot
+// answer:
+//
+//   departure time  one list per minute of the day, in time order, so "all departures between 12:00
+//                   and 15:00" reads the 181 lists of that window and nothing else;
+//   destination     a hash map from destination to the list of flights going there.
+//
+// Each flight's position in both lists is recorded under its number, so erase() and replacing insert()
+// take it out with a swap-remove instead of a search, and without reading the old Flight again.
+// Flights must not be changed while they are in the table, as with HashTable itself.
+class IndexedFlightTable {
+public:
+    // Inserts a flight, or replaces the stored flight with the same number. Throws
+    // std::invalid_argument, leaving the table unchanged, if the departure time is not HH:MM.
+    void insert(Flight* flight) {
+        std::uint16_t minutes = parseDepartureTime(flight->departureTime);
+        erase(flight->flightNumber);
+        table.insert(flight);
+
+        auto list = byDestination.find(std::string_view(flight->destination));
+        if (list == byDestination.end()) list = byDestination.emplace(flight->destination, std::vector<Flight*>()).first;
+        list->second.push_back(flight);
+        byTime[minutes].push_back(flight);
+        places.insert(flight->flightNumber, Place{ &list->second, position(list->second), position(byTime[minutes]), minutes });
+    }
+
+    // Removes the flight with this number; returns false if there is none.
+    bool erase(int key) {
+        Place* place = places.find(key);
+        if (!place) return false;
+
+        std::vector<Flight*>& atTime = byTime[place->minutes];
+        if (place->timePosition + 1 != atTime.size()) {
+            atTime[place->timePosition] = atTime.back();
+            places.find(atTime.back()->flightNumber)->timePosition = place->timePosition;
+        }
+        atTime.pop_back();
+        std::vector<Flight*>& toDestination = *place->destination;
+        if (place->destinationPosition + 1 != toDestination.size()) {
+            toDestination[place->destinationPosition] = toDestination.back();
+            places.find(toDestination.back()->flightNumber)->destinationPosition = place->destinationPosition;
+        }
+        toDestination.pop_back();
+
+        places.erase(key);
+        table.erase(key);
+        return true;
+    }
+
+    Flight* search(int key) { return table.search(key); }
+
+    // Flights departing from `from` to `to` inclusive (minutes since midnight), in departure order (in no
+    // particular order within a minute). When from > to the window runs past midnight.
+    std::vector<Flight*> departuresBetween(std::uint16_t from, std::uint16_t to) const {
+        std::vector<Flight*> result;
+        to = std::min(to, lastMinute);
+        for (std::uint16_t minute = std::min(from, lastMinute);; minute = minute == lastMinute ? 0 : minute + 1) {
+            result.insert(result.end(), byTime[minute].begin(), byTime[minute].end());
+            if (minute == to) break;
+        }
+        return result;
+    }
+
+    // The same with "HH:MM" bounds; throws std::invalid_argument for a malformed one.
+    std::vector<Flight*> departuresBetween(std::string_view from, std::string_view to) const {
+        return departuresBetween(parseDepartureTime(from), parseDepartureTime(to));
+    }
+
+    // Flights to this destination, in no particular order.
+    const std::vector<Flight*>& flightsTo(std::string_view destination) const {
+        static const std::vector<Flight*> none;
+        auto list = byDestination.find(destination);
+        return list != byDestination.end() ? list->second : none;
+    }
+
+    std::size_t size() const { return table.size(); }
+
+    // The primary table, e.g. for scanning every flight.
+    const HashTable& flights() const { return table; }
+
+private:
+    static constexpr std::uint16_t lastMinute = 24 * 60 - 1;
+
+    // Where a flight sits in the indexes. A destination's list stays in the map after its last flight
+    // is erased, so the pointer never dangles.
+    struct Place {
+        std::vector<Flight*>* destination; // map nodes do not move, so neither does the list
+        std::uint32_t destinationPosition;
+        std::uint32_t timePosition;
+        std::uint16_t minutes;
+    };
+
+    static std::uint32_t position(const std::vector<Flight*>& list) {
+        return static_cast<std::uint32_t>(list.size() - 1);
+    }
+
+    // Lets byDestination be searched with a string_view without building a std::string.
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    HashTable table;
+    std::vector<std::vector<Flight*>> byTime = std::vector<std::vector<Flight*>>(lastMinute + 1);
+    std::unordered_map<std::string, std::vector<Flight*>, NameHash, std::equal_to<>> byDestination;
+    FlatHashMap<int, Place> places;
+};
+
+#endif // FLIGHT_INDEX_H
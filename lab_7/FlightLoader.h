@@ -0,0 +1,258 @@
+#ifndef FLIGHT_LOADER_H
+#define FLIGHT_LOADER_H
+
+#include "FlightTable.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Bulk import of flight files into a FlightTable.
+//
+// Two formats are read, both through a read-only memory mapping and without copying any field:
+//
+//   CSV      one flight per line, "number,destination,HH:MM"; an optional header line is skipped.
+//            Destinations cannot contain commas or quotes.
+//   binary   FlightFileHeader, the destination names (uint16 length + bytes each), then, 8-byte
+//            aligned, recordCount FlightRecords whose destination fields index that name list.
+//            Native byte order, written by saveBinary().
+
+struct LoadStats {
+    std::size_t bytes = 0;   // size of the file
+    std::size_t flights = 0; // records read (duplicates replace earlier ones in the table)
+    double parseSeconds = 0;
+    double insertSeconds = 0;
+};
+
+namespace detail
+{
+    struct FlightFileHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t destinationCount;
+        std::uint32_t reserved;
+        std::uint64_t recordCount;
+        std::uint64_t recordsOffset;
+    };
+
+    inline constexpr char flight_file_magic[4] = { 'F', 'L', 'T', '1' };
+    inline constexpr std::uint32_t flight_file_version = 1;
+
+    static_assert(sizeof(FlightRecord) == 8, "FlightRecord is stored as-is in binary flight files");
+
+    // Parses an optionally negative decimal int that fills `field` exactly.
+    inline bool parseInt(std::string_view field, int& value) {
+        bool negative = !field.empty() && field[0] == '-';
+        if (negative) field.remove_prefix(1);
+        if (field.empty() || field.size() > 10) return false;
+        std::int64_t result = 0;
+        for (char c : field) {
+            if (c < '0' || c > '9') return false;
+            result = result * 10 + (c - '0');
+        }
+        if (negative) result = -result;
+        if (result < INT32_MIN || result > INT32_MAX) return false;
+        value = static_cast<int>(result);
+        return true;
+    }
+
+    // Splits off the text up to the next `delim` (or the end), advancing `rest` past the delimiter.
+    inline std::string_view nextField(std::string_view& rest, char delim) {
+        std::size_t pos = rest.find(delim);
+        std::string_view field = rest.substr(0, pos);
+        rest.remove_prefix(pos == std::string_view::npos ? rest.size() : pos + 1);
+        return field;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    inline double secondsSince(Clock::time_point& start) {
+        Clock::time_point now = Clock::now();
+        double seconds = std::chrono::duration<double>(now - start).count();
+        start = now;
+        return seconds;
+    }
+
+    // Records are handed to the table in batches of this many.
+    inline constexpr std::size_t load_batch = 4096;
+} // namespace detail
+
+
+inline LoadStats loadCsv(const std::string& path, FlightTable& table) {
+    io::MappedFile file(path, io::Access::Sequential);
+    std::string_view text(file.data(), file.size());
+    LoadStats stats;
+    stats.bytes = text.size();
+
+    auto clock = detail::Clock::now();
+    // One pass over the newlines is far cheaper than rehashing while the table grows.
+    std::size_t lines = static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+    stats.parseSeconds += detail::secondsSince(clock);
+    table.reserve(table.size() + lines);
+    stats.insertSeconds += detail::secondsSince(clock);
+
+    std::vector<FlightRecord> batch;
+    batch.reserve(detail::load_batch);
+    auto flush = [&] {
+        stats.parseSeconds += detail::secondsSince(clock);
+        table.insert(batch.begin(), batch.end());
+        stats.flights += batch.size();
+        batch.clear();
+        stats.insertSeconds += detail::secondsSince(clock);
+    };
+
+    std::size_t lineNumber = 0;
+    while (!text.empty()) {
+        std::string_view line = detail::nextField(text, '\n');
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        std::string_view rest = line;
+        std::string_view number = detail::nextField(rest, ',');
+        std::string_view destination = detail::nextField(rest, ',');
+        std::string_view time = rest;
+
+        FlightRecord record{};
+        if (!detail::parseInt(number, record.flightNumber)) {
+            if (lineNumber == 1) continue; // header
+            throw std::runtime_error("loadCsv: bad flight number on line " + std::to_string(lineNumber) + " of " + path);
+        }
+        try {
+            record.departureMinutes = parseDepartureTime(time);
+        }
+        catch (const std::invalid_argument&) {
+            throw std::runtime_error("loadCsv: bad departure time on line " + std::to_string(lineNumber) + " of " + path);
+        }
+        record.destination = table.addDestination(destination);
+        batch.push_back(record);
+        if (batch.size() == detail::load_batch) flush();
+    }
+    flush();
+    return stats;
+}
+
+inline LoadStats loadBinary(const std::string& path, FlightTable& table) {
+    io::MappedFile file(path, io::Access::Sequential);
+    LoadStats stats;
+    stats.bytes = file.size();
+
+    detail::FlightFileHeader header{};
+    if (file.size() < sizeof(header)) throw std::runtime_error("loadBinary: truncated file " + path);
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, detail::flight_file_magic, sizeof(header.magic)) != 0 ||
+        header.version != detail::flight_file_version)
+        throw std::runtime_error("loadBinary: not a flight file " + path);
+    if (header.recordsOffset > file.size() || (file.size() - header.recordsOffset) / sizeof(FlightRecord) < header.recordCount)
+        throw std::runtime_error("loadBinary: truncated file " + path);
+
+    auto clock = detail::Clock::now();
+    // File ids to this table's pool ids. Each name takes at least its length field, which bounds the count
+    // before anything is reserved for it.
+    if (header.recordsOffset < sizeof(header) ||
+        header.destinationCount > (header.recordsOffset - sizeof(header)) / sizeof(std::uint16_t))
+        throw std::runtime_error("loadBinary: truncated names in " + path);
+    std::vector<DestinationPool::Id> ids;
+    ids.reserve(header.destinationCount);
+    std::size_t offset = sizeof(header);
+    for (std::uint32_t i = 0; i < header.destinationCount; i++) {
+        std::uint16_t length;
+        if (offset + sizeof(length) > header.recordsOffset) throw std::runtime_error("loadBinary: truncated names in " + path);
+        std::memcpy(&length, file.data() + offset, sizeof(length));
+        offset += sizeof(length);
+        if (offset + length > header.recordsOffset) throw std::runtime_error("loadBinary: truncated names in " + path);
+        ids.push_back(table.addDestination(std::string_view(file.data() + offset, length)));
+        offset += length;
+    }
+    stats.parseSeconds += detail::secondsSince(clock);
+    table.reserve(table.size() + header.recordCount);
+    stats.insertSeconds += detail::secondsSince(clock);
+
+    const char* records = file.data() + header.recordsOffset;
+    std::vector<FlightRecord> batch(detail::load_batch);
+    for (std::uint64_t done = 0; done < header.recordCount;) {
+        std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(detail::load_batch, header.recordCount - done));
+        std::memcpy(batch.data(), records + done * sizeof(FlightRecord), n * sizeof(FlightRecord));
+        for (std::size_t i = 0; i < n; i++) {
+            if (batch[i].destination >= ids.size()) throw std::runtime_error("loadBinary: bad destination id in " + path);
+            batch[i].destination = ids[batch[i].destination];
+        }
+        stats.parseSeconds += detail::secondsSince(clock);
+        table.insert(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(n));
+        stats.insertSeconds += detail::secondsSince(clock);
+        done += n;
+    }
+    stats.flights = static_cast<std::size_t>(header.recordCount);
+    return stats;
+}
+
+// Picks the format from the first bytes of the file.
+inline LoadStats loadFlights(const std::string& path, FlightTable& table) {
+    char magic[sizeof(detail::flight_file_magic)] = {};
+    std::ifstream(path, std::ios::binary).read(magic, sizeof(magic));
+    if (std::memcmp(magic, detail::flight_file_magic, sizeof(magic)) == 0) return loadBinary(path, table);
+    return loadCsv(path, table);
+}
+
+// Writes the table in the binary format. Throws std::runtime_error on I/O failure.
+inline void saveBinary(const FlightTable& table, const std::string& path) {
+    const DestinationPool& pool = table.destinations();
+    detail::FlightFileHeader header{};
+    std::memcpy(header.magic, detail::flight_file_magic, sizeof(header.magic));
+    header.version = detail::flight_file_version;
+    header.destinationCount = static_cast<std::uint32_t>(pool.size());
+    header.recordCount = table.size();
+    std::uint64_t namesEnd = sizeof(header);
+    for (std::size_t id = 0; id < pool.size(); id++) namesEnd += sizeof(std::uint16_t) + pool.name(static_cast<DestinationPool::Id>(id)).size();
+    header.recordsOffset = (namesEnd + 7) & ~std::uint64_t(7);
+
+    std::vector<char> buffer(1 << 20);
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("saveBinary: cannot open " + path);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (std::size_t id = 0; id < pool.size(); id++) {
+        std::string_view name = pool.name(static_cast<DestinationPool::Id>(id));
+        if (name.size() > UINT16_MAX) throw std::runtime_error("saveBinary: destination name too long");
+        std::uint16_t length = static_cast<std::uint16_t>(name.size());
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+    const char padding[8] = {};
+    out.write(padding, static_cast<std::streamsize>(header.recordsOffset - namesEnd));
+    table.for_each([&](const FlightRecord& record) {
+        out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    });
+    if (!out.flush()) throw std::runtime_error("saveBinary: write failed for " + path);
+}
+
+// Flight numbers separated by whitespace, e.g. one per line.
+inline std::vector<int> readFlightNumbers(const std::string& path) {
+    io::MappedFile file(path, io::Access::Sequential);
+    std::string_view text(file.data(), file.size());
+    std::vector<int> numbers;
+    numbers.reserve(text.size() / 6);
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        pos = text.find_first_not_of(" \t\r\n", pos);
+        if (pos == std::string_view::npos) break;
+        std::size_t end = std::min(text.find_first_of(" \t\r\n", pos), text.size());
+        int number;
+        if (!detail::parseInt(text.substr(pos, end - pos), number))
+            throw std::runtime_error("readFlightNumbers: bad flight number in " + path);
+        numbers.push_back(number);
+        pos = end;
+    }
+    return numbers;
+}
+
+#endif // FLIGHT_LOADER_H
@@ -0,0 +1,172 @@
+#ifndef FLIGHT_TABLE_H
+#define FLIGHT_TABLE_H
+
+#include "FlatHashMap.h"
+#include "HashTable.h"
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Interns destination names: each distinct name is stored once and referred to by a 16-bit id.
+class DestinationPool {
+public:
+    using Id = std::uint16_t;
+
+    Id intern(std::string_view name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        if (names.size() > std::numeric_limits<Id>::max())
+            throw std::length_error("DestinationPool: too many destinations");
+        names.emplace_back(name);
+        Id id = static_cast<Id>(names.size() - 1);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+
+    std::string_view name(Id id) const { return names[id]; }
+
+    std::size_t size() const { return names.size(); }
+
+    // Approximate heap memory: the names and the hash index over them.
+    std::size_t bytes() const {
+        std::size_t total = names.size() * sizeof(std::string) + ids.bucket_count() * sizeof(void*);
+        for (const std::string& name : names) {
+            if (name.capacity() > std::string().capacity()) total += name.capacity() + 1;
+        }
+        return total + ids.size() * (sizeof(std::pair<const std::string_view, Id>) + 2 * sizeof(void*));
+    }
+
+private:
+    std::deque<std::string> names; // never relocated, so the views in `ids` stay valid
+    std::unordered_map<std::string_view, Id> ids;
+};
+
+
+// A flight in 8 bytes: departure time as minutes since midnight, destination as a pool id.
+struct FlightRecord {
+    int flightNumber;
+    std::uint16_t departureMinutes;
+    DestinationPool::Id destination;
+};
+
+// "H:MM" or "HH:MM" to minutes since midnight; throws std::invalid_argument for anything else.
+inline std::uint16_t parseDepartureTime(std::string_view time) {
+    std::size_t colon = time.find(':');
+    if (colon == std::string_view::npos || colon == 0 || colon > 2 || time.size() != colon + 3)
+        throw std::invalid_argument("parseDepartureTime: expected HH:MM, got " + std::string(time));
+    int hours = 0, minutes = 0;
+    for (std::size_t i = 0; i < time.size(); i++) {
+        if (i == colon) continue;
+        if (time[i] < '0' || time[i] > '9')
+            throw std::invalid_argument("parseDepartureTime: expected HH:MM, got " + std::string(time));
+        int& part = i < colon ? hours : minutes;
+        part = part * 10 + (time[i] - '0');
+    }
+    if (hours > 23 || minutes > 59)
+        throw std::invalid_argument("parseDepartureTime: no such time " + std::string(time));
+    return static_cast<std::uint16_t>(hours * 60 + minutes);
+}
+
+inline std::string formatDepartureTime(std::uint16_t minutes) {
+    std::string time = "00:00";
+    time[0] = static_cast<char>('0' + minutes / 600);
+    time[1] = static_cast<char>('0' + minutes / 60 % 10);
+    time[3] = static_cast<char>('0' + minutes % 60 / 10);
+    time[4] = static_cast<char>('0' + minutes % 10);
+    return time;
+}
+
+
+// Flight table that owns its data. Records are stored inline in a FlatHashMap slot -- 8 bytes each,
+// flight number included -- so a lookup touches the table and nothing else, and callers need not keep
+// their Flight objects alive.
+class FlightTable {
+public:
+    // Inserts a flight, or replaces the stored flight with the same number.
+    void insert(int flightNumber, std::string_view destination, std::string_view departureTime) {
+        records.insert(flightNumber, Info{ parseDepartureTime(departureTime), pool.intern(destination) });
+    }
+
+    void insert(const Flight& flight) {
+        insert(flight.flightNumber, flight.destination, flight.departureTime);
+    }
+
+    // The record's destination must be an id returned by addDestination() and its time a minute of the
+    // day; throws std::invalid_argument otherwise, as the text overloads do.
+    void insert(const FlightRecord& record) {
+        if (record.destination >= pool.size())
+            throw std::invalid_argument("FlightTable::insert: unknown destination id " + std::to_string(record.destination));
+        if (record.departureMinutes >= 24 * 60)
+            throw std::invalid_argument("FlightTable::insert: no such time " + std::to_string(record.departureMinutes) + " minutes");
+        records.insert(record.flightNumber, Info{ record.departureMinutes, record.destination });
+    }
+
+    // Batch insert: reserves room for the whole batch, then inserts while prefetching the slots of
+    // records a few positions ahead. A record that fails the checks above stops the batch there.
+    template <std::random_access_iterator It>
+    void insert(It first, It last) {
+        constexpr std::ptrdiff_t lookahead = 8;
+        std::ptrdiff_t n = last - first;
+        records.reserve(records.size() + static_cast<std::size_t>(n));
+        for (std::ptrdiff_t i = 0; i < n; i++) {
+            if (i + lookahead < n) records.prefetch(first[i + lookahead].flightNumber);
+            insert(first[i]);
+        }
+    }
+
+    DestinationPool::Id addDestination(std::string_view name) { return pool.intern(name); }
+
+    bool erase(int flightNumber) { return records.erase(flightNumber); }
+
+    std::optional<FlightRecord> find(int flightNumber) const {
+        const Info* info = records.find(flightNumber);
+        if (!info) return std::nullopt;
+        return FlightRecord{ flightNumber, info->departureMinutes, info->destination };
+    }
+
+    // The flight with its strings rebuilt, for callers that want a Flight back.
+    std::optional<Flight> search(int flightNumber) const {
+        std::optional<FlightRecord> record = find(flightNumber);
+        if (!record) return std::nullopt;
+        return Flight{ std::string(destination(*record)), flightNumber, formatDepartureTime(record->departureMinutes) };
+    }
+
+    std::string_view destination(const FlightRecord& record) const { return pool.name(record.destination); }
+
+    // Calls fn(record) for every flight, in table order.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        records.for_each([&](int flightNumber, const Info& info) {
+            fn(FlightRecord{ flightNumber, info.departureMinutes, info.destination });
+        });
+    }
+
+    void reserve(std::size_t n) { records.reserve(n); }
+
+    std::size_t size() const { return records.size(); }
+
+    const DestinationPool& destinations() const { return pool; }
+
+    // Heap memory held by the table and the destination pool.
+    std::size_t bytes() const { return records.bytes() + pool.bytes(); }
+
+    double bytesPerRecord() const { return size() ? static_cast<double>(bytes()) / size() : 0.0; }
+
+private:
+    struct Info {
+        std::uint16_t departureMinutes;
+        DestinationPool::Id destination;
+    };
+
+    FlatHashMap<int, Info> records;
+    DestinationPool pool;
+};
+
+#endif // FLIGHT_TABLE_H
@@ -0,0 +1,132 @@
+#ifndef HASH_POLICIES_H
+#define HASH_POLICIES_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// Policies for BasicHashTable.
+//
+// A hash policy maps a flight number to its home slot, hash1(key, M) in [0, M), and to a double
+// hashing step, hash2(key, M) in [1, M - 2]. A probe policy says how to get from one slot of a probe
+// sequence to the next and which capacities that works with.
+
+namespace detail
+{
+    // High 64 bits of the 128-bit product a * b.
+    inline std::uint64_t mulhi(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return __umulh(a, b);
+#else
+        std::uint64_t aLo = a & 0xffffffff, aHi = a >> 32, bLo = b & 0xffffffff, bHi = b >> 32;
+        std::uint64_t mid = aHi * bLo + ((aLo * bLo) >> 32);
+        return aHi * bHi + (mid >> 32) + ((aLo * bHi + (mid & 0xffffffff)) >> 32);
+#endif
+    }
+
+    // Maps the full 64-bit range onto [0, n) with a multiply instead of a division.
+    inline std::size_t reduce(std::uint64_t h, std::size_t n) {
+        return static_cast<std::size_t>(mulhi(h, n));
+    }
+
+    inline std::uint64_t rotl32(std::uint64_t h) {
+        return (h << 32) | (h >> 32);
+    }
+} // namespace detail
+
+
+// The textbook pair: key % M and 1 + key % (M - 2).
+struct ModuloHash {
+    static std::size_t hash1(int key, std::size_t M) {
+        return static_cast<unsigned int>(key) % M;
+    }
+
+    static std::size_t hash2(int key, std::size_t M) {
+        return 1 + static_cast<unsigned int>(key) % (M - 2);
+    }
+};
+
+// Multiplicative (Fibonacci) hashing: the key times 2^64 / phi, with the slot taken from the high bits
+// of the product. Both halves of the product are linear in the key, so under double hashing evenly
+// spaced keys get probe sequences that run along each other.
+struct FibonacciHash {
+    static std::uint64_t scramble(int key) {
+        return static_cast<std::uint64_t>(static_cast<unsigned int>(key)) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    static std::size_t hash1(int key, std::size_t M) {
+        return detail::reduce(scramble(key), M);
+    }
+
+    static std::size_t hash2(int key, std::size_t M) {
+        return 1 + detail::reduce(detail::rotl32(scramble(key)), M - 2);
+    }
+};
+
+// wyhash-style mixer: one 64x64 -> 128-bit multiply whose halves are folded together, so every key
+// bit reaches every hash bit.
+struct MixHash {
+    static std::uint64_t scramble(int key) {
+        std::uint64_t a = static_cast<unsigned int>(key) ^ 0xa0761d6478bd642fULL;
+        std::uint64_t b = 0xe7037ed1a0b428dbULL;
+        return (a * b) ^ detail::mulhi(a, b);
+    }
+
+    static std::size_t hash1(int key, std::size_t M) {
+        return detail::reduce(scramble(key), M);
+    }
+
+    static std::size_t hash2(int key, std::size_t M) {
+        return 1 + detail::reduce(detail::rotl32(scramble(key)), M - 2);
+    }
+};
+
+
+// next(index, step, i, M) returns the slot after `index`, where i is the number of slots probed so far
+// and step is hash2 of the key (only double hashing reads it).
+
+struct LinearProbing {
+    static constexpr bool primeCapacity = false;
+    static constexpr bool usesStep = false;
+    static constexpr bool robinHood = false;
+
+    static std::size_t next(std::size_t index, std::size_t, std::size_t, std::size_t M) {
+        return index + 1 == M ? 0 : index + 1;
+    }
+};
+
+// Triangular offsets 1, 3, 6, 10, ... from the home slot. They visit every slot when M is a power of
+// two, which is why this policy asks for one.
+struct QuadraticProbing {
+    static constexpr bool primeCapacity = false;
+    static constexpr bool usesStep = false;
+    static constexpr bool robinHood = false;
+
+    static std::size_t next(std::size_t index, std::size_t, std::size_t i, std::size_t M) {
+        return (index + i) & (M - 1);
+    }
+};
+
+// Steps downward by hash2; any step in [1, M - 2] is coprime with a prime M.
+struct DoubleHashing {
+    static constexpr bool primeCapacity = true;
+    static constexpr bool usesStep = true;
+    static constexpr bool robinHood = false;
+
+    static std::size_t next(std::size_t index, std::size_t step, std::size_t, std::size_t M) {
+        return index >= step ? index - step : index + M - step;
+    }
+};
+
+// Linear probing where an insert displaces any flight that sits closer to its home slot than the new
+// one would, which keeps probe lengths even and lets a search stop as soon as it meets such a flight.
+struct RobinHoodProbing : LinearProbing {
+    static constexpr bool robinHood = true;
+};
+
+#endif // HASH_POLICIES_H
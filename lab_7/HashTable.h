@@ -0,0 +1,367 @@
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+#include "HashPolicies.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+struct Flight {
+    std::string destination;
+    int flightNumber;
+    std::string departureTime;
+};
+
+// Shape of the occupied part of a table, see BasicHashTable::stats().
+struct HashTableStats {
+    double averageProbe = 0;   // slots a successful search inspects, on average
+    double probeVariance = 0;
+    std::size_t maxProbe = 0;
+    double averageCluster = 0; // runs of consecutive non-empty slots (flights and tombstones)
+    std::size_t maxCluster = 0;
+    std::size_t clusters = 0;
+};
+
+// Open-addressing table of flights keyed by flightNumber. Hash (see HashPolicies.h) picks the home slot
+// and the double hashing step; Probe picks how the sequence continues from there.
+//
+// Erased slots become tombstones: search() steps over them and insert() reuses them (except under
+// Robin Hood probing, see place()). Once live flights plus tombstones would exceed
+// maxLoadFactor * capacity, or tombstones alone pass maxTombstoneFactor * capacity, the table starts
+// over in a fresh slot array -- twice as large if it is really full, the same size if it is mostly
+// tombstones. The old array is drained incrementally: each insert() and erase() moves at most
+// migrationStep of its slots, so no single operation pays for a whole rehash.
+template <typename Probe, typename Hash>
+class BasicHashTable {
+public:
+    static constexpr std::size_t defaultCapacity = 10;
+    static constexpr double defaultMaxLoadFactor = 0.7;
+    static constexpr double maxTombstoneFactor = 0.2;
+    static constexpr std::size_t migrationStep = 64;
+
+    explicit BasicHashTable(std::size_t capacity = defaultCapacity, double maxLoadFactor = defaultMaxLoadFactor)
+            : active(roundCapacity(capacity)), maxLoad(clampLoadFactor(maxLoadFactor)) {}
+
+    // Inserts a flight, or replaces the stored flight with the same number.
+    void insert(Flight* flight) {
+        migrate(migrationStep);
+        int key = flight->flightNumber;
+        if (Flight** slot = find(key)) {
+            *slot = flight;
+            return;
+        }
+        if (active.used + active.deleted + 1 > maxLoad * active.M) rebuild();
+        active.place(flight);
+        ++count;
+    }
+
+    // Removes the flight with this number; returns false if there is none.
+    bool erase(int key) {
+        migrate(migrationStep);
+        if (!active.erase(key) && !(draining.M && draining.erase(key))) return false;
+        --count;
+        if (!draining.M && active.deleted > maxTombstoneFactor * active.M) rebuild();
+        return true;
+    }
+
+    Flight* search(int key) {
+        Flight** slot = find(key);
+        return slot ? *slot : nullptr;
+    }
+
+    // Grows the table so that n flights fit without exceeding the load factor. Rehashes eagerly.
+    void reserve(std::size_t n) {
+        finishMigration();
+        std::size_t needed = static_cast<std::size_t>(n / maxLoad) + 1;
+        if (needed > active.M) {
+            startRehash(roundCapacity(needed));
+            finishMigration();
+        }
+    }
+
+    std::size_t size() const { return count; }
+
+    std::size_t capacity() const { return active.M; }
+
+    double loadFactor() const { return static_cast<double>(count) / active.M; }
+
+    double maxLoadFactor() const { return maxLoad; }
+
+    void setMaxLoadFactor(double maxLoadFactor) {
+        maxLoad = clampLoadFactor(maxLoadFactor);
+        reserve(count);
+    }
+
+    std::size_t tombstones() const { return active.deleted; }
+
+    bool rehashing() const { return draining.M != 0; }
+
+    // Probe lengths of the stored flights and the clusters they form. Finishes a pending rehash first.
+    HashTableStats stats() {
+        finishMigration();
+        HashTableStats result;
+        if (!count) return result;
+
+        std::size_t totalProbe = 0, totalSquares = 0;
+        for (std::size_t index = 0; index < active.M; index++) {
+            if (active.state[index] != Occupied) continue;
+            std::size_t probe = active.probeLength(active.table[index]->flightNumber, index);
+            totalProbe += probe;
+            totalSquares += probe * probe;
+            result.maxProbe = std::max(result.maxProbe, probe);
+        }
+        result.averageProbe = static_cast<double>(totalProbe) / count;
+        result.probeVariance = static_cast<double>(totalSquares) / count - result.averageProbe * result.averageProbe;
+
+        // Start right after an empty slot so that a cluster wrapping around the end is counted once.
+        std::size_t start = 0;
+        while (active.state[start] != Empty) start++;
+        std::size_t run = 0, total = 0;
+        for (std::size_t i = 1; i <= active.M; i++) {
+            std::size_t index = (start + i) % active.M;
+            if (active.state[index] != Empty) {
+                run++;
+                continue;
+            }
+            if (run) {
+                result.clusters++;
+                total += run;
+                result.maxCluster = std::max(result.maxCluster, run);
+            }
+            run = 0;
+        }
+        result.averageCluster = result.clusters ? static_cast<double>(total) / result.clusters : 0.0;
+        return result;
+    }
+
+    // Calls fn(flight) for every stored flight, in slot order. Does not disturb a pending rehash.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const Slots* slots : { &active, &draining }) {
+            for (std::size_t i = 0; i < slots->M; i++) {
+                if (slots->state[i] == Occupied) fn(slots->table[i]);
+            }
+        }
+    }
+
+    void display() {
+        finishMigration();
+        std::cout << "-:" << std::endl;
+        for (std::size_t i = 0; i < active.M; i++) {
+            Flight* flight = active.table[i];
+            if (active.state[i] == Occupied) {
+                std::cout << i << ": " << flight->flightNumber << " -> " << flight->destination << " (" << flight->departureTime << ")" << std::endl;
+            }
+            else if (active.state[i] == Deleted) {
+                std::cout << i << ": " << std::endl;
+            }
+            else {
+                std::cout << i << ": " << std::endl;
+            }
+        }
+    }
+
+private:
+    enum SlotState : unsigned char { Empty = 0, Occupied = 1, Deleted = 2 };
+
+    struct FreeDeleter {
+        void operator()(void* p) const { std::free(p); }
+    };
+
+    // Zero-filled storage from calloc: large arrays come straight from fresh pages, so starting a
+    // rehash does not have to clear the new array up front.
+    template <typename T>
+    static std::unique_ptr<T[], FreeDeleter> zeroed(std::size_t n) {
+        void* p = std::calloc(n, sizeof(T));
+        if (!p) throw std::bad_alloc();
+        return std::unique_ptr<T[], FreeDeleter>(static_cast<T*>(p));
+    }
+
+    struct Slots {
+        std::size_t M = 0;
+        std::size_t used = 0;
+        std::size_t deleted = 0;
+        std::unique_ptr<Flight*[], FreeDeleter> table;
+        std::unique_ptr<SlotState[], FreeDeleter> state;
+
+        Slots() = default;
+
+        explicit Slots(std::size_t capacity)
+            : M(capacity), table(zeroed<Flight*>(capacity)), state(zeroed<SlotState>(capacity)) {}
+
+        std::size_t hash1(int key) const {
+            return Hash::hash1(key, M);
+        }
+
+        std::size_t hash2(int key) const {
+            if constexpr (Probe::usesStep) return Hash::hash2(key, M);
+            else return 0;
+        }
+
+        std::size_t next(std::size_t index, std::size_t step, std::size_t i) const {
+            return Probe::next(index, step, i, M);
+        }
+
+        // How far the flight in slot `index` sits from its home slot, in probes. Robin Hood only.
+        std::size_t distance(std::size_t index) const {
+            std::size_t home = hash1(table[index]->flightNumber);
+            return index >= home ? index - home : index + M - home;
+        }
+
+        Flight** find(int key) const {
+            std::size_t index = hash1(key);
+            std::size_t step = hash2(key);
+
+            for (std::size_t i = 0; i < M; i++) {
+                if (state[index] == Empty) return nullptr;
+                if (state[index] == Occupied) {
+                    if (table[index]->flightNumber == key) return &table[index];
+                    // Had the key been here, its insert would have displaced this richer flight.
+                    if constexpr (Probe::robinHood) {
+                        if (distance(index) < i) return nullptr;
+                    }
+                }
+                index = next(index, step, i + 1);
+            }
+            return nullptr;
+        }
+
+        // Puts a flight into the first free or deleted slot of its probe sequence; the caller has
+        // checked that the key is absent and that the array is below its load limit.
+        //
+        // Robin Hood probing instead carries the flight along until it finds an empty slot, swapping it
+        // with every flight that is closer to home. Tombstones are stepped over rather than reused: a
+        // flight dropped into one could land ahead of flights that are further from home, and the early
+        // exit in find() would then miss them.
+        void place(Flight* flight) {
+            std::size_t index = hash1(flight->flightNumber);
+            std::size_t step = hash2(flight->flightNumber);
+
+            if constexpr (Probe::robinHood) {
+                for (std::size_t d = 0; state[index] != Empty; d++) {
+                    if (state[index] == Occupied) {
+                        std::size_t other = distance(index);
+                        if (other < d) {
+                            std::swap(flight, table[index]);
+                            d = other;
+                        }
+                    }
+                    index = next(index, step, d + 1);
+                }
+            }
+            else {
+                for (std::size_t i = 1; state[index] == Occupied; i++) {
+                    index = next(index, step, i);
+                }
+                if (state[index] == Deleted) --deleted;
+            }
+            table[index] = flight;
+            state[index] = Occupied;
+            ++used;
+        }
+
+        // Slots a search for key inspects before it reaches `target`.
+        std::size_t probeLength(int key, std::size_t target) const {
+            std::size_t index = hash1(key);
+            std::size_t step = hash2(key);
+            std::size_t i = 0;
+            while (index != target) index = next(index, step, ++i);
+            return i + 1;
+        }
+
+        bool erase(int key) {
+            Flight** slot = find(key);
+            if (!slot) return false;
+            std::size_t index = static_cast<std::size_t>(slot - table.get());
+            table[index] = nullptr;
+            state[index] = Deleted;
+            --used;
+            ++deleted;
+            return true;
+        }
+    };
+
+    Slots active;
+    Slots draining;       // previous slot array while a rehash is in progress
+    std::size_t cursor = 0; // next draining slot to migrate
+    double maxLoad;
+    std::size_t count = 0;
+
+    Flight** find(int key) {
+        if (Flight** slot = active.find(key)) return slot;
+        if (draining.M) return draining.find(key);
+        return nullptr;
+    }
+
+    // Starts over in a fresh array: twice as large if live flights alone fill half the load limit,
+    // otherwise the same size, which just drops the tombstones.
+    void rebuild() {
+        // A previous rehash can only still be running if the table filled unusually fast; finish it first.
+        finishMigration();
+        bool full = count + 1 > maxLoad * active.M / 2;
+        startRehash(full ? roundCapacity(2 * active.M) : active.M);
+    }
+
+    void startRehash(std::size_t newCapacity) {
+        draining = std::move(active);
+        active = Slots(newCapacity);
+        cursor = 0;
+    }
+
+    // Moves up to `steps` slots of the draining array into the active one.
+    void migrate(std::size_t steps) {
+        if (!draining.M) return;
+        for (std::size_t end = std::min(draining.M, cursor + steps); cursor < end; ++cursor) {
+            if (draining.state[cursor] == Occupied) {
+                active.place(draining.table[cursor]);
+                // A tombstone rather than Empty keeps the probe chains through this slot intact.
+                draining.state[cursor] = Deleted;
+            }
+        }
+        if (cursor == draining.M) draining = Slots();
+    }
+
+    void finishMigration() {
+        if (draining.M) migrate(draining.M);
+    }
+
+    static double clampLoadFactor(double loadFactor) {
+        if (loadFactor < 0.1) return 0.1;
+        if (loadFactor > 0.95) return 0.95;
+        return loadFactor;
+    }
+
+    static bool isPrime(std::size_t n) {
+        if (n < 2) return false;
+        if (n % 2 == 0) return n == 2;
+        for (std::size_t d = 3; d * d <= n; d += 2) {
+            if (n % d == 0) return false;
+        }
+        return true;
+    }
+
+    // Smallest prime >= max(n, 5), so that hash2 always has a non-empty range.
+    static std::size_t nextPrime(std::size_t n) {
+        if (n < 5) n = 5;
+        while (!isPrime(n)) ++n;
+        return n;
+    }
+
+    static std::size_t roundCapacity(std::size_t n) {
+        if constexpr (Probe::primeCapacity) return nextPrime(n);
+        std::size_t capacity = 8;
+        while (capacity < n) capacity *= 2;
+        return capacity;
+    }
+};
+
+using HashTable = BasicHashTable<DoubleHashing, MixHash>;
+
+#endif // HASH_TABLE_H
@@ -0,0 +1,214 @@
+#ifndef PERFECT_HASH_TABLE_H
+#define PERFECT_HASH_TABLE_H
+
+#include "HashPolicies.h"
+#include "HashTable.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Read-only flight table over a minimal perfect hash function, for schedules that are loaded once and
+// then only searched.
+//
+// The function follows CHD (compress, hash, displace): the keys are hashed into about n / bucketSize
+// buckets, and every bucket gets a displacement pair (d0, d1) that sends its keys to
+//
+//     slot = (h1(key) + d0 * h2(key) + d1) mod n
+//
+// The build places the largest buckets first, while the table is still mostly free, and searches the
+// pairs until every key of the bucket lands on a free slot; single-key buckets just take the next free
+// slot through d1. The n slots end up holding exactly the n flights, so search() reads one bucket's
+// displacement, then one slot, and compares the key stored there.
+class PerfectHashTable {
+public:
+    static constexpr double defaultBucketSize = 5.0;
+
+    // Builds the table. A flight number that appears twice keeps the later flight, as insert() would.
+    // Throws std::runtime_error in the (practically impossible) case that no seed yields a function.
+    explicit PerfectHashTable(const std::vector<Flight*>& flights, double bucketSize = defaultBucketSize) {
+        std::vector<Flight*> unique = latestPerKey(flights);
+        for (seed = 1; seed <= maxAttempts; seed++) {
+            if (build(unique, bucketSize)) return;
+        }
+        throw std::runtime_error("PerfectHashTable: no perfect hash function found");
+    }
+
+    Flight* search(int key) const {
+        if (slots.empty()) return nullptr;
+        Hashes h = hashes(key);
+        std::size_t bucket = detail::reduce(h.bucket, d1.size());
+        const Slot& slot = slots[position(h, d0[bucket], d1[bucket])];
+        return slot.key == key ? slot.flight : nullptr;
+    }
+
+    std::size_t size() const { return slots.size(); }
+
+    std::size_t bucketCount() const { return d1.size(); }
+
+    // Seeds tried before the build succeeded.
+    std::uint64_t attempts() const { return seed; }
+
+    // Size of the hash function itself (the displacements), not counting the slots.
+    double bitsPerKey() const {
+        return slots.empty() ? 0.0 : 8.0 * d1.size() * (sizeof(std::uint8_t) + sizeof(std::uint32_t)) / slots.size();
+    }
+
+    // Heap memory of displacements and slots.
+    std::size_t bytes() const {
+        return d0.capacity() * sizeof(std::uint8_t) + d1.capacity() * sizeof(std::uint32_t) + slots.capacity() * sizeof(Slot);
+    }
+
+private:
+    static constexpr std::uint64_t maxAttempts = 64;
+    static constexpr unsigned maxD0 = 256;
+
+    struct Slot {
+        int key = 0;
+        Flight* flight = nullptr;
+    };
+
+    struct Hashes {
+        std::uint64_t bucket;
+        std::size_t h1;
+        std::size_t h2;
+    };
+
+    std::uint64_t seed = 0;
+    std::vector<std::uint8_t> d0;
+    std::vector<std::uint32_t> d1;
+    std::vector<Slot> slots;
+
+    // Same mixer as MixHash, keyed by the seed so that a failed build can start over with new hashes.
+    static std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+        return (a * b) ^ detail::mulhi(a, b);
+    }
+
+    Hashes hashes(int key) const {
+        std::uint64_t g = mix(static_cast<unsigned int>(key) ^ 0xa0761d6478bd642fULL ^ (seed * 0x9E3779B97F4A7C15ULL), 0xe7037ed1a0b428dbULL);
+        std::uint64_t s = mix(g ^ 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL);
+        std::size_t n = slots.size();
+        return { g, detail::reduce(s, n), detail::reduce(detail::rotl32(s), n) };
+    }
+
+    std::size_t position(const Hashes& h, std::uint64_t displacement0, std::uint64_t displacement1) const {
+        return static_cast<std::size_t>((h.h1 + displacement0 * h.h2 + displacement1) % slots.size());
+    }
+
+    static std::vector<Flight*> latestPerKey(const std::vector<Flight*>& flights) {
+        std::vector<std::pair<int, std::size_t>> order;
+        order.reserve(flights.size());
+        for (std::size_t i = 0; i < flights.size(); i++) order.emplace_back(flights[i]->flightNumber, i);
+        std::sort(order.begin(), order.end());
+        std::vector<Flight*> unique;
+        unique.reserve(order.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            if (i + 1 < order.size() && order[i + 1].first == order[i].first) continue;
+            unique.push_back(flights[order[i].second]);
+        }
+        return unique;
+    }
+
+    bool build(const std::vector<Flight*>& flights, double bucketSize) {
+        std::size_t n = flights.size();
+        // A handful of keys sharing one or two buckets would need luck to land on a permutation of the
+        // slots, so small schedules get up to one bucket per key; the function stays tiny either way.
+        std::size_t buckets = std::max<std::size_t>({ 1, std::min<std::size_t>(n, 64), static_cast<std::size_t>(n / bucketSize) });
+        slots.assign(n, Slot{});
+        d0.assign(buckets, 0);
+        d1.assign(buckets, 0);
+        if (n == 0) return true;
+
+        std::vector<Hashes> h(n);
+        std::vector<std::size_t> start(buckets + 1, 0);
+        for (std::size_t i = 0; i < n; i++) {
+            h[i] = hashes(flights[i]->flightNumber);
+            start[detail::reduce(h[i].bucket, buckets) + 1]++;
+        }
+        // Keys grouped by bucket, then buckets ordered from largest to smallest.
+        std::size_t largest = 0;
+        for (std::size_t b = 0; b < buckets; b++) {
+            largest = std::max(largest, start[b + 1]);
+            start[b + 1] += start[b];
+        }
+        std::vector<std::size_t> members(n), fill(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < n; i++) members[fill[detail::reduce(h[i].bucket, buckets)]++] = i;
+        std::vector<std::size_t> bySize(largest + 2, 0), order(buckets);
+        for (std::size_t b = 0; b < buckets; b++) bySize[largest - (start[b + 1] - start[b]) + 1]++;
+        for (std::size_t s = 0; s <= largest; s++) bySize[s + 1] += bySize[s];
+        for (std::size_t b = 0; b < buckets; b++) order[bySize[largest - (start[b + 1] - start[b])]++] = b;
+
+        std::vector<std::uint8_t> taken(n, 0);
+        std::vector<std::size_t> base;
+        std::size_t nextFree = 0;
+        for (std::size_t b : order) {
+            std::size_t first = start[b], count = start[b + 1] - first;
+            if (count == 0) break;
+            if (count == 1) {
+                while (taken[nextFree]) nextFree++;
+                const Hashes& one = h[members[first]];
+                d1[b] = static_cast<std::uint32_t>((nextFree + n - one.h1) % n);
+                place(flights[members[first]], nextFree, taken);
+                continue;
+            }
+            if (!displace(b, first, count, flights, members, h, taken, base)) return false;
+        }
+        return true;
+    }
+
+    // Finds (d0, d1) for a bucket of several keys and places them.
+    bool displace(std::size_t b, std::size_t first, std::size_t count, const std::vector<Flight*>& flights,
+                  const std::vector<std::size_t>& members, const std::vector<Hashes>& h,
+                  std::vector<std::uint8_t>& taken, std::vector<std::size_t>& base) {
+        std::size_t n = slots.size();
+        for (unsigned displacement0 = 0; displacement0 < maxD0; displacement0++) {
+            base.clear();
+            for (std::size_t k = 0; k < count; k++) base.push_back(position(h[members[first + k]], displacement0, 0));
+            // With d0 fixed the keys keep their distances for every d1, so they must not coincide.
+            bool distinct = true;
+            for (std::size_t i = 0; i < count && distinct; i++) {
+                for (std::size_t j = i + 1; j < count; j++) distinct = distinct && base[i] != base[j];
+            }
+            if (!distinct) continue;
+
+            // Only shifts that put the first key on a free slot can work, so jump from one free slot to
+            // the next (memchr skips the taken runs, which get long as the table fills up).
+            for (std::size_t tried = 0; tried < n;) {
+                std::size_t from = (base[0] + tried) % n;
+                const void* free = std::memchr(taken.data() + from, 0, n - from);
+                if (!free) {
+                    tried += n - from; // wrap around to the start of the table
+                    continue;
+                }
+                std::size_t slot0 = static_cast<std::size_t>(static_cast<const std::uint8_t*>(free) - taken.data());
+                tried += slot0 - from + 1;
+                std::size_t displacement1 = (slot0 + n - base[0]) % n;
+
+                bool fits = true;
+                for (std::size_t k = 1; k < count && fits; k++) {
+                    std::size_t slot = base[k] + displacement1;
+                    fits = !taken[slot >= n ? slot - n : slot];
+                }
+                if (!fits) continue;
+                d0[b] = static_cast<std::uint8_t>(displacement0);
+                d1[b] = static_cast<std::uint32_t>(displacement1);
+                for (std::size_t k = 0; k < count; k++) {
+                    std::size_t slot = base[k] + displacement1;
+                    place(flights[members[first + k]], slot >= n ? slot - n : slot, taken);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void place(Flight* flight, std::size_t slot, std::vector<std::uint8_t>& taken) {
+        slots[slot] = Slot{ flight->flightNumber, flight };
+        taken[slot] = 1;
+    }
+};
+
+#endif // PERFECT_HASH_TABLE_H
@@ -0,0 +1,200 @@
+#ifndef ROBIN_HOOD_HASH_TABLE_H
+#define ROBIN_HOOD_HASH_TABLE_H
+
+#include "HashTable.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Linear-probing table of flights in which every slot records how far it sits from its home slot.
+//
+// An insert carries its flight forward and swaps it with any flight that is closer to home, so along
+// a run the distances never drop by more than one per slot. A search can therefore stop at the first
+// slot whose distance is smaller than its own: the key would have displaced that flight. erase()
+// shifts the following flights of the run one slot back instead of leaving a tombstone, so the table
+// never fills up with deleted slots and probe lengths stay short and even up to high load factors.
+//
+// Each slot keeps the flight number next to the pointer, so probing never dereferences a Flight.
+template <typename Hash>
+class BasicRobinHoodTable {
+public:
+    static constexpr std::size_t defaultCapacity = 16;
+    static constexpr double defaultMaxLoadFactor = 0.9;
+
+    explicit BasicRobinHoodTable(std::size_t capacity = defaultCapacity, double maxLoadFactor = defaultMaxLoadFactor)
+        : slots(roundCapacity(capacity)), maxLoad(clampLoadFactor(maxLoadFactor)) {}
+
+    // Inserts a flight, or replaces the stored flight with the same number.
+    void insert(Flight* flight) {
+        if (count + 1 > maxLoad * slots.size()) {
+            // Only a new key takes a slot; replacing one must not grow the table.
+            std::size_t existing = find(flight->flightNumber);
+            if (existing != npos) {
+                slots[existing].flight = flight;
+                return;
+            }
+            rehash(2 * slots.size());
+        }
+
+        Slot carry{ flight->flightNumber, 1, flight };
+        std::size_t index = home(carry.key);
+        bool displaced = false;
+        while (slots[index].distance) {
+            Slot& slot = slots[index];
+            // Until the first swap we are still looking for the key itself.
+            if (!displaced && slot.key == carry.key && slot.distance == carry.distance) {
+                slot.flight = flight;
+                return;
+            }
+            if (slot.distance < carry.distance) {
+                std::swap(slot, carry);
+                displaced = true;
+            }
+            carry.distance++;
+            index = next(index);
+        }
+        slots[index] = carry;
+        ++count;
+    }
+
+    // Removes the flight with this number; returns false if there is none.
+    bool erase(int key) {
+        std::size_t index = find(key);
+        if (index == npos) return false;
+        // Backward shift: pull the rest of the run one slot closer to home, up to an empty slot or a
+        // flight that already sits in its home slot.
+        for (std::size_t following = next(index); slots[following].distance > 1; following = next(following)) {
+            slots[index] = slots[following];
+            slots[index].distance--;
+            index = following;
+        }
+        slots[index] = Slot{};
+        --count;
+        return true;
+    }
+
+    Flight* search(int key) const {
+        std::size_t index = find(key);
+        return index != npos ? slots[index].flight : nullptr;
+    }
+
+    // Grows the table so that n flights fit without exceeding the load factor.
+    void reserve(std::size_t n) {
+        std::size_t needed = static_cast<std::size_t>(n / maxLoad) + 1;
+        if (needed > slots.size()) rehash(roundCapacity(needed));
+    }
+
+    std::size_t size() const { return count; }
+
+    std::size_t capacity() const { return slots.size(); }
+
+    double loadFactor() const { return static_cast<double>(count) / slots.size(); }
+
+    double maxLoadFactor() const { return maxLoad; }
+
+    void setMaxLoadFactor(double maxLoadFactor) {
+        maxLoad = clampLoadFactor(maxLoadFactor);
+        reserve(count);
+    }
+
+    // The stored distance is the probe length of a successful search.
+    HashTableStats stats() const {
+        HashTableStats result;
+        if (!count) return result;
+
+        std::size_t totalProbe = 0, totalSquares = 0;
+        for (const Slot& slot : slots) {
+            if (!slot.distance) continue;
+            totalProbe += slot.distance;
+            totalSquares += std::size_t(slot.distance) * slot.distance;
+            result.maxProbe = std::max<std::size_t>(result.maxProbe, slot.distance);
+        }
+        result.averageProbe = static_cast<double>(totalProbe) / count;
+        result.probeVariance = static_cast<double>(totalSquares) / count - result.averageProbe * result.averageProbe;
+
+        // Start right after an empty slot so that a cluster wrapping around the end is counted once.
+        std::size_t start = 0;
+        while (slots[start].distance) start++;
+        std::size_t run = 0, total = 0;
+        for (std::size_t i = 1; i <= slots.size(); i++) {
+            if (slots[(start + i) & (slots.size() - 1)].distance) {
+                run++;
+                continue;
+            }
+            if (run) {
+                result.clusters++;
+                total += run;
+                result.maxCluster = std::max(result.maxCluster, run);
+            }
+            run = 0;
+        }
+        result.averageCluster = result.clusters ? static_cast<double>(total) / result.clusters : 0.0;
+        return result;
+    }
+
+    void display() const {
+        std::cout << "- (Robin Hood):" << std::endl;
+        for (std::size_t i = 0; i < slots.size(); i++) {
+            const Slot& slot = slots[i];
+            if (slot.distance) {
+                std::cout << i << ": " << slot.key << " -> " << slot.flight->destination << " (" << slot.flight->departureTime
+                          << "),  " << slot.distance - 1 << std::endl;
+            }
+            else {
+                std::cout << i << ": " << std::endl;
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        int key = 0;
+        std::uint32_t distance = 0; // 1 + slots from home; 0 marks an empty slot
+        Flight* flight = nullptr;
+    };
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    std::vector<Slot> slots;
+    double maxLoad;
+    std::size_t count = 0;
+
+    std::size_t home(int key) const { return Hash::hash1(key, slots.size()); }
+
+    std::size_t next(std::size_t index) const { return (index + 1) & (slots.size() - 1); }
+
+    std::size_t find(int key) const {
+        std::size_t index = home(key);
+        for (std::uint32_t distance = 1; slots[index].distance >= distance; distance++) {
+            if (slots[index].key == key) return index;
+            index = next(index);
+        }
+        return npos;
+    }
+
+    void rehash(std::size_t newCapacity) {
+        std::vector<Slot> old(roundCapacity(newCapacity));
+        std::swap(slots, old);
+        count = 0;
+        for (const Slot& slot : old) {
+            if (slot.distance) insert(slot.flight);
+        }
+    }
+
+    static double clampLoadFactor(double loadFactor) {
+        if (loadFactor < 0.1) return 0.1;
+        if (loadFactor > 0.95) return 0.95;
+        return loadFactor;
+    }
+
+    static std::size_t roundCapacity(std::size_t n) {
+        std::size_t capacity = 8;
+        while (capacity < n) capacity *= 2;
+        return capacity;
+    }
+};
+
+using RobinHoodHashTable = BasicRobinHoodTable<MixHash>;
+
+#endif // ROBIN_HOOD_HASH_TABLE_H
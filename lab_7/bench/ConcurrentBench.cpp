@@ -0,0 +1,98 @@
+#include "../ConcurrentHashTable.h"
+#include "BenchUtils.h"
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Read/write mixes against a HashTable behind one global mutex and against ConcurrentHashTable.
+// Usage: Lab7ConcurrentBench [flights] [ops per thread] [max threads] [read percent]
+// Without a read percent, 99%, 90% and 50% reads are measured.
+namespace
+{
+    struct LockedTable {
+        HashTable table;
+        std::mutex mutex;
+
+        bool search(int key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return table.search(key) != nullptr;
+        }
+        void insert(Flight* flight) {
+            std::lock_guard<std::mutex> lock(mutex);
+            table.insert(flight);
+        }
+        void erase(int key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            table.erase(key);
+        }
+    };
+
+    struct SharedTable {
+        ConcurrentHashTable table;
+
+        bool search(int key) { return table.search(key) != nullptr; }
+        void insert(Flight* flight) { table.insert(flight); }
+        void erase(int key) { table.erase(key); }
+    };
+
+    // Half of the flights are in the table to begin with; writes insert or erase random flights.
+    template <typename Table>
+    double run(Table& t, std::vector<Flight>& flights, std::size_t ops, unsigned threads, unsigned readPercent)
+    {
+        std::vector<std::thread> workers;
+        return bench::measure([&] {
+            for (unsigned th = 0; th < threads; ++th) {
+                workers.emplace_back([&, th] {
+                    std::mt19937 gen(th + 1);
+                    std::uniform_int_distribution<std::size_t> flightDist(0, flights.size() - 1);
+                    std::uniform_int_distribution<unsigned> opDist(0, 99);
+                    std::size_t hits = 0;
+                    for (std::size_t i = 0; i < ops; ++i) {
+                        Flight& flight = flights[flightDist(gen)];
+                        unsigned op = opDist(gen);
+                        if (op < readPercent) hits += t.search(flight.flightNumber);
+                        else if (op % 2) t.insert(&flight);
+                        else t.erase(flight.flightNumber);
+                    }
+                    bench::doNotOptimize(hits);
+                });
+            }
+            for (auto& w : workers) w.join();
+        });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    std::size_t ops = bench::argOr(argc, argv, 2, 1'000'000);
+    unsigned maxThreads = static_cast<unsigned>(bench::argOr(argc, argv, 3, 32));
+    std::vector<unsigned> readPercents = { 99u, 90u, 50u };
+    if (argc > 4) readPercents = { static_cast<unsigned>(bench::argOr(argc, argv, 4, 90)) };
+
+    std::vector<Flight> flights(2 * n);
+    for (std::size_t i = 0; i < flights.size(); ++i)
+        flights[i] = { "City", static_cast<int>((i + 1) * 101), "12:00" };
+
+    std::cout << "flights: " << n << ", ops per thread: " << ops
+              << ", hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (unsigned readPercent : readPercents) {
+        std::cout << "\n" << readPercent << "% reads / " << 100 - readPercent << "% writes" << std::endl;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            LockedTable locked;
+            SharedTable shared;
+            for (std::size_t i = 0; i < flights.size(); i += 2) {
+                locked.table.insert(&flights[i]);
+                shared.table.insert(&flights[i]);
+            }
+
+            double tLocked = run(locked, flights, ops, threads, readPercent);
+            double tShared = run(shared, flights, ops, threads, readPercent);
+            bench::report("mutex HashTable, " + std::to_string(threads) + " threads", tLocked, ops * threads);
+            bench::report("ConcurrentHashTable, " + std::to_string(threads) + " threads", tShared, ops * threads);
+        }
+    }
+    return 0;
+}
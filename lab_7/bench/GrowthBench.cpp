@@ -0,0 +1,55 @@
+#include "../HashTable.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Insert and search throughput while the table grows from its default capacity.
+// Flight numbers follow the lab's clustered pattern (101, 202, 303, ...).
+// Usage: Lab7GrowthBench [max flights]
+int main(int argc, char** argv)
+{
+    std::size_t maxFlights = bench::argOr(argc, argv, 1, 10'000'000);
+
+    std::vector<Flight> flights(maxFlights);
+    for (std::size_t i = 0; i < maxFlights; ++i)
+        flights[i] = { "City", static_cast<int>((i + 1) * 101), "12:00" };
+
+    for (std::size_t n = 10; n <= maxFlights; n *= 10) {
+        std::vector<int> keys(n);
+        for (std::size_t i = 0; i < n; ++i) keys[i] = flights[i].flightNumber;
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+        // Repeat small sizes so the timings are measurable.
+        std::size_t rounds = std::max<std::size_t>(1, 1'000'000 / n);
+        HashTable table;
+        double insertTime = bench::measure([&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                table = HashTable();
+                for (std::size_t i = 0; i < n; ++i) table.insert(&flights[i]);
+            }
+        });
+
+        std::size_t found = 0;
+        double hitTime = bench::measure([&] {
+            for (std::size_t r = 0; r < rounds; ++r)
+                for (int key : keys) found += table.search(key) != nullptr;
+        });
+        double missTime = bench::measure([&] {
+            for (std::size_t r = 0; r < rounds; ++r)
+                for (int key : keys) found += table.search(key + 1) != nullptr;
+        });
+
+        std::cout << n << " flights, capacity " << table.capacity()
+                  << ", load factor " << table.loadFactor() << std::endl;
+        bench::report("  insert", insertTime, n * rounds);
+        bench::report("  search hit", hitTime, n * rounds);
+        bench::report("  search miss", missTime, n * rounds);
+
+        if (found != n * rounds) {
+            std::cerr << "expected " << n * rounds << " hits, got " << found << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "../FlightLoader.h"
+#include "BenchUtils.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Bulk import speed: generates a CSV flight file, loads it, saves the table in the binary format and
+// loads that. Parse rate is in MB of file per second, insert rate in flights per second.
+// Usage: Lab7ImportBench [flights] [file prefix]
+namespace
+{
+    const char* const cities[] = {
+        "Moscow", "Saint Petersburg", "Novosibirsk", "Yekaterinburg", "Kazan", "Nizhny Novgorod",
+        "Chelyabinsk", "Samara", "Omsk", "Rostov-on-Don", "Ufa", "Krasnoyarsk", "Voronezh", "Perm",
+        "Volgograd", "Krasnodar", "Saratov", "Tyumen", "Tolyatti", "Izhevsk", "Barnaul", "Ulyanovsk",
+        "Irkutsk", "Khabarovsk", "Yaroslavl", "Vladivostok", "Makhachkala", "Tomsk", "Orenburg",
+        "Kemerovo", "Novokuznetsk", "Ryazan", "Astrakhan", "Naberezhnye Chelny", "Penza", "Kirov",
+    };
+
+    void reportLoad(const std::string& name, const LoadStats& stats)
+    {
+        std::cout << std::left << std::setw(12) << name << std::right << std::fixed
+                  << std::setw(10) << std::setprecision(1) << stats.bytes / 1e6 << " MB"
+                  << std::setw(10) << std::setprecision(1) << stats.bytes / 1e6 / stats.parseSeconds << " MB/s parse"
+                  << std::setw(14) << std::setprecision(0) << stats.flights / stats.insertSeconds << " flights/s insert"
+                  << std::setw(10) << std::setprecision(1) << (stats.parseSeconds + stats.insertSeconds) * 1e3 << " ms total"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 4'000'000);
+    std::string prefix = argc > 2 ? argv[2] : "lab7_import";
+    std::string csvPath = prefix + ".csv";
+    std::string binaryPath = prefix + ".bin";
+
+    {
+        std::mt19937 gen(5);
+        std::uniform_int_distribution<std::size_t> cityDist(0, std::size(cities) - 1);
+        std::uniform_int_distribution<int> minuteDist(0, 24 * 60 - 1);
+        std::string text = "number,destination,departure\n";
+        text.reserve(n * 24);
+        for (std::size_t i = 0; i < n; ++i) {
+            text += std::to_string((i + 1) * 101 % 2'000'000'011);
+            text += ',';
+            text += cities[cityDist(gen)];
+            text += ',';
+            text += formatDepartureTime(static_cast<std::uint16_t>(minuteDist(gen)));
+            text += '\n';
+        }
+        std::ofstream(csvPath, std::ios::binary).write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    std::cout << "flights: " << n << std::endl;
+    FlightTable fromCsv;
+    reportLoad("csv", loadCsv(csvPath, fromCsv));
+    saveBinary(fromCsv, binaryPath);
+    FlightTable fromBinary;
+    reportLoad("binary", loadFlights(binaryPath, fromBinary));
+
+    bool same = fromCsv.size() == fromBinary.size();
+    fromCsv.for_each([&](const FlightRecord& record) {
+        std::optional<FlightRecord> copy = fromBinary.find(record.flightNumber);
+        same = same && copy && copy->departureMinutes == record.departureMinutes &&
+               fromBinary.destination(*copy) == fromCsv.destination(record);
+    });
+    std::remove(csvPath.c_str());
+    std::remove(binaryPath.c_str());
+    if (!same) {
+        std::cerr << "binary load does not match the csv load" << std::endl;
+        return 1;
+    }
+    return 0;
+}
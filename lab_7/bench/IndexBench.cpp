@@ -0,0 +1,116 @@
+#include "../FlightIndex.h"
+#include "../HashTable.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// Range and destination queries through IndexedFlightTable against a full scan of the HashTable,
+// plus what keeping the indexes up to date costs on insert and erase.
+// Usage: Lab7IndexBench [flights] [queries]
+namespace
+{
+    const char* const cities[] = {
+        "Moscow", "Saint Petersburg", "Novosibirsk", "Yekaterinburg", "Kazan", "Nizhny Novgorod",
+        "Chelyabinsk", "Samara", "Omsk", "Rostov-on-Don", "Ufa", "Krasnoyarsk", "Voronezh", "Perm",
+        "Volgograd", "Krasnodar", "Saratov", "Tyumen", "Tolyatti", "Izhevsk", "Barnaul", "Ulyanovsk",
+        "Irkutsk", "Khabarovsk", "Yaroslavl", "Vladivostok", "Makhachkala", "Tomsk", "Orenburg",
+        "Kemerovo", "Novokuznetsk", "Ryazan", "Astrakhan", "Naberezhnye Chelny", "Penza", "Kirov",
+        "Lipetsk", "Kaliningrad", "Sochi", "Murmansk", "Arkhangelsk", "Yakutsk", "Magadan",
+        "Petropavlovsk-Kamchatsky", "Yuzhno-Sakhalinsk", "Norilsk", "Syktyvkar", "Salekhard",
+    };
+
+    // "HH:MM" strings compare like the times they spell, so the scan needs no parsing.
+    std::size_t scanDepartures(const HashTable& table, const std::string& from, const std::string& to)
+    {
+        std::size_t found = 0;
+        table.for_each([&](const Flight* flight) {
+            found += flight->departureTime >= from && flight->departureTime <= to;
+        });
+        return found;
+    }
+
+    std::size_t scanDestination(const HashTable& table, const std::string& destination)
+    {
+        std::size_t found = 0;
+        table.for_each([&](const Flight* flight) { found += flight->destination == destination; });
+        return found;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    std::size_t queries = bench::argOr(argc, argv, 2, 100);
+    std::mt19937 gen(13);
+    std::uniform_int_distribution<std::size_t> cityDist(0, std::size(cities) - 1);
+    std::uniform_int_distribution<int> minuteDist(0, 24 * 60 - 1);
+
+    std::vector<Flight> flights(n);
+    for (std::size_t i = 0; i < n; ++i)
+        flights[i] = { cities[cityDist(gen)], static_cast<int>((i + 1) * 101), formatDepartureTime(static_cast<std::uint16_t>(minuteDist(gen))) };
+
+    HashTable plain;
+    double plainInsert = bench::measure([&] {
+        for (auto& flight : flights) plain.insert(&flight);
+    });
+    IndexedFlightTable indexed;
+    double indexedInsert = bench::measure([&] {
+        for (auto& flight : flights) indexed.insert(&flight);
+    });
+
+    std::cout << "flights: " << n << ", queries per kind: " << queries << std::endl;
+    bench::report("HashTable insert", plainInsert, n);
+    bench::report("IndexedFlightTable insert", indexedInsert, n);
+
+    // Windows of 3 hours and of 10 minutes at random starting times (not wrapping past midnight).
+    std::vector<std::pair<std::string, std::string>> wide, narrow;
+    for (std::size_t q = 0; q < queries; ++q) {
+        int start = std::uniform_int_distribution<int>(0, 21 * 60 - 1)(gen);
+        wide.emplace_back(formatDepartureTime(static_cast<std::uint16_t>(start)), formatDepartureTime(static_cast<std::uint16_t>(start + 180)));
+        narrow.emplace_back(formatDepartureTime(static_cast<std::uint16_t>(start)), formatDepartureTime(static_cast<std::uint16_t>(start + 9)));
+    }
+    std::vector<std::string> destinations;
+    for (std::size_t q = 0; q < queries; ++q) destinations.push_back(cities[cityDist(gen)]);
+
+    std::size_t scanned = 0, looked = 0;
+    for (auto* windows : { &wide, &narrow }) {
+        std::string label = windows == &wide ? "3 h window" : "10 min window";
+        bench::report("scan, " + label, bench::measure([&] {
+            for (const auto& [from, to] : *windows) scanned += scanDepartures(indexed.flights(), from, to);
+        }), queries);
+        bench::report("time index, " + label, bench::measure([&] {
+            for (const auto& [from, to] : *windows) looked += indexed.departuresBetween(from, to).size();
+        }), queries);
+    }
+    bench::report("scan, destination", bench::measure([&] {
+        for (const auto& destination : destinations) scanned += scanDestination(indexed.flights(), destination);
+    }), queries);
+    bench::report("destination index", bench::measure([&] {
+        for (const auto& destination : destinations) {
+            for (const Flight* flight : indexed.flightsTo(destination)) looked += flight->flightNumber != 0;
+        }
+    }), queries);
+    if (scanned != looked) {
+        std::cerr << "index results differ from the scan: " << looked << " vs " << scanned << std::endl;
+        return 1;
+    }
+
+    // Churn: erase a random flight and put it back.
+    std::vector<std::size_t> victims(n);
+    for (auto& v : victims) v = gen() % n;
+    bench::report("HashTable erase + insert", bench::measure([&] {
+        for (std::size_t v : victims) {
+            plain.erase(flights[v].flightNumber);
+            plain.insert(&flights[v]);
+        }
+    }), n);
+    bench::report("IndexedFlightTable erase + insert", bench::measure([&] {
+        for (std::size_t v : victims) {
+            indexed.erase(flights[v].flightNumber);
+            indexed.insert(&flights[v]);
+        }
+    }), n);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "../HashTable.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Per-operation latency percentiles while the table grows, and under insert/erase churn.
+// Usage: Lab7LatencyBench [flights]
+namespace
+{
+    template <typename Op>
+    std::vector<double> timeEach(std::size_t n, Op op)
+    {
+        std::vector<double> ns(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            op(i);
+            auto stop = std::chrono::steady_clock::now();
+            ns[i] = std::chrono::duration<double, std::nano>(stop - start).count();
+        }
+        return ns;
+    }
+
+    void percentiles(const std::string& name, std::vector<double> ns)
+    {
+        std::sort(ns.begin(), ns.end());
+        auto at = [&](double q) { return ns[std::min(ns.size() - 1, static_cast<std::size_t>(q * ns.size()))]; };
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(0)
+                  << " p50 " << std::setw(6) << at(0.5) << " ns"
+                  << "  p99 " << std::setw(6) << at(0.99) << " ns"
+                  << "  p999 " << std::setw(8) << at(0.999) << " ns"
+                  << "  max " << std::setw(10) << ns.back() << " ns" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 2'000'000);
+
+    std::vector<Flight> flights(n);
+    for (std::size_t i = 0; i < n; ++i)
+        flights[i] = { "City", static_cast<int>((i + 1) * 101), "12:00" };
+    std::shuffle(flights.begin(), flights.end(), std::mt19937(42));
+
+    std::cout << "flights: " << n << std::endl;
+
+    HashTable table;
+    percentiles("HashTable insert (growth)", timeEach(n, [&](std::size_t i) { table.insert(&flights[i]); }));
+
+    std::unordered_map<int, Flight*> reference;
+    percentiles("unordered_map insert", timeEach(n, [&](std::size_t i) {
+        reference.emplace(flights[i].flightNumber, &flights[i]);
+    }));
+
+    // Churn: erase a random flight and put it back, which keeps producing tombstones.
+    std::mt19937 gen(7);
+    std::vector<std::size_t> victims(n);
+    for (auto& v : victims) v = gen() % n;
+    percentiles("HashTable erase+insert", timeEach(n, [&](std::size_t i) {
+        table.erase(flights[victims[i]].flightNumber);
+        table.insert(&flights[victims[i]]);
+    }));
+    percentiles("unordered_map erase+insert", timeEach(n, [&](std::size_t i) {
+        reference.erase(flights[victims[i]].flightNumber);
+        reference.emplace(flights[victims[i]].flightNumber, &flights[victims[i]]);
+    }));
+
+    for (const auto& flight : flights) {
+        if (table.search(flight.flightNumber) != &flight) {
+            std::cerr << "lost flight " << flight.flightNumber << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "../FlatHashMap.h"
+#include "../HashTable.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Hit and miss lookups in HashTable (pointers to flights), FlatHashMap (flights stored inline) and
+// std::unordered_map, for the lab's evenly spaced flight numbers and for random ones.
+// Usage: Lab7LookupBench [flights]
+namespace
+{
+    void run(const std::string& pattern, const std::vector<int>& keys, const std::vector<int>& misses)
+    {
+        std::size_t n = keys.size();
+        std::vector<Flight> flights(n);
+        for (std::size_t i = 0; i < n; ++i) flights[i] = { "City", keys[i], "12:00" };
+
+        HashTable table;
+        FlatHashMap<int, Flight> flat;
+        std::unordered_map<int, Flight*> reference;
+        for (auto& flight : flights) {
+            table.insert(&flight);
+            flat.insert(flight.flightNumber, flight);
+            reference.emplace(flight.flightNumber, &flight);
+        }
+
+        std::vector<int> order(keys);
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+        std::cout << pattern << ": " << n << " flights, FlatHashMap group width " << FlatHashMap<int, Flight>::groupWidth
+                  << ", load factor " << flat.loadFactor() << std::endl;
+
+        // Every hit reads the flight, so the pointer tables pay for the extra indirection.
+        long long sum = 0;
+        bench::report("  HashTable hit", bench::measure([&] {
+            for (int key : order) sum += table.search(key)->flightNumber;
+        }), n);
+        bench::report("  FlatHashMap hit", bench::measure([&] {
+            for (int key : order) sum += flat.find(key)->flightNumber;
+        }), n);
+        bench::report("  unordered_map hit", bench::measure([&] {
+            for (int key : order) sum += reference.find(key)->second->flightNumber;
+        }), n);
+
+        std::size_t found = 0;
+        bench::report("  HashTable miss", bench::measure([&] {
+            for (int key : misses) found += table.search(key) != nullptr;
+        }), misses.size());
+        bench::report("  FlatHashMap miss", bench::measure([&] {
+            for (int key : misses) found += flat.find(key) != nullptr;
+        }), misses.size());
+        bench::report("  unordered_map miss", bench::measure([&] {
+            for (int key : misses) found += reference.count(key);
+        }), misses.size());
+
+        bench::doNotOptimize(sum);
+        if (found != 0) std::cerr << "unexpected hits for absent keys: " << found << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    std::mt19937 gen(7);
+
+    std::vector<int> keys(n), misses(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = static_cast<int>((i + 1) * 101);
+        misses[i] = keys[i] + 1;
+    }
+    std::shuffle(misses.begin(), misses.end(), gen);
+    run("sequential", keys, misses);
+
+    // Random even keys are present, odd ones are absent.
+    std::vector<int> random;
+    random.reserve(n);
+    while (random.size() < n) random.push_back(static_cast<int>(gen() & 0x7ffffffe));
+    std::sort(random.begin(), random.end());
+    random.erase(std::unique(random.begin(), random.end()), random.end());
+    std::shuffle(random.begin(), random.end(), gen);
+    for (std::size_t i = 0; i < random.size(); ++i) misses[i] = random[i] + 1;
+    misses.resize(random.size());
+    run("random", random, misses);
+    return 0;
+}
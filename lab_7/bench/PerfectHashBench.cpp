@@ -0,0 +1,90 @@
+#include "../HashTable.h"
+#include "../PerfectHashTable.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Build time, size and lookup cost of HashTable against PerfectHashTable built from the same flights.
+// "latency" chains the lookups -- which key comes next depends on the previous result -- so it shows the
+// cost of a single search rather than of many overlapping ones.
+// Usage: Lab7PerfectHashBench [flights]
+namespace
+{
+    template <typename Table>
+    void lookups(const std::string& name, Table& table, const std::vector<int>& keys, const std::vector<int>& misses)
+    {
+        std::size_t n = keys.size();
+        long long sum = 0;
+        double hit = bench::measure([&] {
+            for (int key : keys) sum += table.search(key)->flightNumber;
+        });
+        std::size_t index = 0;
+        double latency = bench::measure([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                const Flight* flight = table.search(keys[index]);
+                index = i + 1 - (flight->flightNumber == -1);
+            }
+        });
+        std::size_t found = 0;
+        double miss = bench::measure([&] {
+            for (int key : misses) found += table.search(key) != nullptr;
+        });
+        bench::doNotOptimize(sum);
+        bench::doNotOptimize(index);
+        if (found) std::cerr << name << ": unexpected hits for absent keys: " << found << std::endl;
+
+        std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(1)
+                  << " hit " << std::setw(6) << hit * 1e9 / n << " ns"
+                  << "   latency " << std::setw(6) << latency * 1e9 / n << " ns"
+                  << "   miss " << std::setw(6) << miss * 1e9 / misses.size() << " ns" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    std::mt19937 gen(11);
+
+    std::vector<Flight> flights(n);
+    std::vector<Flight*> pointers(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        flights[i] = { "City", static_cast<int>((i + 1) * 101), "12:00" };
+        pointers[i] = &flights[i];
+    }
+    std::vector<int> keys(n), misses(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = flights[i].flightNumber;
+        misses[i] = keys[i] + 1;
+    }
+    std::shuffle(keys.begin(), keys.end(), gen);
+    std::shuffle(misses.begin(), misses.end(), gen);
+
+    HashTable table;
+    double tableBuild = bench::measure([&] {
+        for (Flight* flight : pointers) table.insert(flight);
+    });
+    std::unique_ptr<PerfectHashTable> perfect;
+    double perfectBuild = bench::measure([&] { perfect = std::make_unique<PerfectHashTable>(pointers); });
+
+    std::cout << "flights: " << n << ", perfect hash: " << perfect->bucketCount() << " buckets, "
+              << perfect->attempts() << " seed(s) tried" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "HashTable           build " << std::setw(8) << tableBuild * 1e3 << " ms   "
+              << static_cast<double>(table.capacity() * (sizeof(Flight*) + 1)) * 8 / n << " bits per key" << std::endl
+              << "PerfectHashTable    build " << std::setw(8) << perfectBuild * 1e3 << " ms   "
+              << static_cast<double>(perfect->bytes()) * 8 / n << " bits per key ("
+              << perfect->bitsPerKey() << " for the hash function)" << std::endl;
+
+    lookups("HashTable", table, keys, misses);
+    lookups("PerfectHashTable", *perfect, keys, misses);
+
+    for (const Flight& flight : flights) {
+        if (perfect->search(flight.flightNumber) != &flight) {
+            std::cerr << "wrong flight for " << flight.flightNumber << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
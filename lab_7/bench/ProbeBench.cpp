@@ -0,0 +1,110 @@
+#include "../HashTable.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Every probing policy with every hash policy, on the lab's evenly spaced flight numbers and on
+// random ones: average and longest successful probe, cluster sizes, and insert/hit/miss throughput.
+// Usage: Lab7ProbeBench [flights]
+namespace
+{
+    struct Keys {
+        std::vector<Flight> flights;
+        std::vector<int> hits;   // present keys in shuffled order
+        std::vector<int> misses; // absent keys
+    };
+
+    Keys sequentialKeys(std::size_t n)
+    {
+        Keys keys;
+        for (std::size_t i = 0; i < n; ++i) {
+            int key = static_cast<int>((i + 1) * 101);
+            keys.flights.push_back({ "City", key, "12:00" });
+            keys.hits.push_back(key);
+            keys.misses.push_back(key + 1);
+        }
+        std::shuffle(keys.hits.begin(), keys.hits.end(), std::mt19937(1));
+        return keys;
+    }
+
+    // Random even numbers; the odd neighbours are the misses.
+    Keys randomKeys(std::size_t n)
+    {
+        std::mt19937 gen(2);
+        std::vector<int> values;
+        while (values.size() < n) values.push_back(static_cast<int>(gen() & 0x7ffffffe));
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        std::shuffle(values.begin(), values.end(), gen);
+
+        Keys keys;
+        for (int key : values) {
+            keys.flights.push_back({ "City", key, "12:00" });
+            keys.hits.push_back(key);
+            keys.misses.push_back(key + 1);
+        }
+        std::shuffle(keys.hits.begin(), keys.hits.end(), gen);
+        return keys;
+    }
+
+    template <typename Probe, typename Hash>
+    void run(const std::string& name, Keys& keys)
+    {
+        BasicHashTable<Probe, Hash> table;
+        double insertTime = bench::measure([&] {
+            for (auto& flight : keys.flights) table.insert(&flight);
+        });
+
+        std::size_t found = 0;
+        double hitTime = bench::measure([&] {
+            for (int key : keys.hits) found += table.search(key) != nullptr;
+        });
+        double missTime = bench::measure([&] {
+            for (int key : keys.misses) found += table.search(key) != nullptr;
+        });
+        if (found != keys.hits.size()) std::cerr << name << ": wrong number of hits " << found << std::endl;
+
+        HashTableStats stats = table.stats();
+        auto mops = [](std::size_t ops, double seconds) { return ops / seconds / 1e6; };
+        std::cout << std::left << std::setw(34) << name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(8) << stats.averageProbe
+                  << std::setw(8) << stats.maxProbe
+                  << std::setw(10) << stats.averageCluster
+                  << std::setw(9) << stats.maxCluster
+                  << std::setprecision(1)
+                  << std::setw(9) << mops(keys.flights.size(), insertTime)
+                  << std::setw(9) << mops(keys.hits.size(), hitTime)
+                  << std::setw(9) << mops(keys.misses.size(), missTime) << std::endl;
+    }
+
+    template <typename Probe>
+    void runHashes(const std::string& probe, Keys& keys)
+    {
+        run<Probe, ModuloHash>(probe + " / modulo", keys);
+        run<Probe, FibonacciHash>(probe + " / fibonacci", keys);
+        run<Probe, MixHash>(probe + " / mix", keys);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+
+    Keys sequential = sequentialKeys(n);
+    Keys random = randomKeys(n);
+    for (Keys* keys : { &sequential, &random }) {
+        std::cout << (keys == &sequential ? "sequential" : "random") << " flight numbers, "
+                  << keys->flights.size() << " flights" << std::endl;
+        std::cout << std::left << std::setw(34) << "probe / hash" << std::right
+                  << std::setw(8) << "avg" << std::setw(8) << "max"
+                  << std::setw(10) << "cluster" << std::setw(9) << "max"
+                  << std::setw(9) << "ins M/s" << std::setw(9) << "hit M/s" << std::setw(9) << "miss M/s" << std::endl;
+        runHashes<LinearProbing>("linear", *keys);
+        runHashes<QuadraticProbing>("quadratic", *keys);
+        runHashes<DoubleHashing>("double", *keys);
+        runHashes<RobinHoodProbing>("robin hood", *keys);
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "../RobinHoodHashTable.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Probe length mean, variance and maximum, and hit/miss throughput, for the Robin Hood table against
+// the double hashing and linear probing HashTable at fixed load factors from 0.5 to 0.9 -- first right
+// after filling, then after a round of erase/insert churn. HashTable may rehash into a larger array
+// during the churn to clear its tombstones, so its load factor is printed alongside.
+// Usage: Lab7RobinHoodBench [capacity]
+namespace
+{
+    // 2n flights: the table is filled with the first n, then churn replaces them one by one with the
+    // second n, erasing one flight and inserting a new one per step.
+    struct Workload {
+        std::vector<Flight> flights;
+        std::size_t n;
+
+        // Present keys of one half in shuffled order, and absent keys next to them.
+        std::vector<int> hits(std::size_t half) const
+        {
+            std::vector<int> keys;
+            for (std::size_t i = half * n; i < (half + 1) * n; ++i) keys.push_back(flights[i].flightNumber);
+            std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+            return keys;
+        }
+    };
+
+    Workload makeWorkload(std::size_t n, bool sequential)
+    {
+        std::mt19937 gen(11);
+        std::vector<int> keys;
+        if (sequential) {
+            for (std::size_t i = 0; i < 2 * n; ++i) keys.push_back(static_cast<int>((i + 1) * 101));
+        }
+        else {
+            // Even numbers, so key + 1 is always a miss.
+            while (keys.size() < 2 * n) {
+                while (keys.size() < 2 * n) keys.push_back(static_cast<int>(gen() & 0x7ffffffe));
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+            }
+        }
+        std::shuffle(keys.begin(), keys.end(), gen);
+
+        Workload w{ {}, n };
+        for (int key : keys) w.flights.push_back({ "City", key, "12:00" });
+        return w;
+    }
+
+    template <typename Table>
+    void run(const std::string& name, Table& table, Workload& w)
+    {
+        auto row = [&](const std::string& phase, std::size_t half) {
+            std::vector<int> hits = w.hits(half);
+            std::size_t found = 0;
+            double hitTime = bench::measure([&] {
+                for (int key : hits) found += table.search(key) != nullptr;
+            });
+            double missTime = bench::measure([&] {
+                for (int key : hits) found += table.search(key + 1) != nullptr;
+            });
+            if (found != hits.size()) std::cerr << name << ": wrong number of hits " << found << std::endl;
+
+            HashTableStats stats = table.stats();
+            std::cout << "  " << std::left << std::setw(22) << name << std::setw(8) << phase << std::right << std::fixed
+                      << std::setprecision(2) << std::setw(6) << table.loadFactor()
+                      << std::setw(8) << stats.averageProbe
+                      << std::setw(10) << stats.probeVariance
+                      << std::setw(8) << stats.maxProbe
+                      << std::setprecision(1)
+                      << std::setw(10) << hits.size() / hitTime / 1e6
+                      << std::setw(10) << hits.size() / missTime / 1e6 << std::endl;
+        };
+
+        for (std::size_t i = 0; i < w.n; ++i) table.insert(&w.flights[i]);
+        row("filled", 0);
+        for (std::size_t i = 0; i < w.n; ++i) {
+            table.erase(w.flights[i].flightNumber);
+            table.insert(&w.flights[w.n + i]);
+        }
+        row("churned", 1);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t capacity = bench::argOr(argc, argv, 1, 1 << 20);
+
+    for (bool sequential : { true, false }) {
+        std::cout << (sequential ? "sequential" : "random") << " flight numbers" << std::endl;
+        for (double load : { 0.5, 0.6, 0.7, 0.8, 0.9 }) {
+            // The tables are sized up front and allowed to fill to 0.95, so each run sits at `load`.
+            Workload w = makeWorkload(static_cast<std::size_t>(load * capacity), sequential);
+            std::cout << "load factor " << load << std::endl;
+            std::cout << "  " << std::left << std::setw(30) << "table" << std::right << std::setw(6) << "load" << std::setw(8) << "avg"
+                      << std::setw(10) << "variance" << std::setw(8) << "max"
+                      << std::setw(10) << "hit M/s" << std::setw(10) << "miss M/s" << std::endl;
+
+            RobinHoodHashTable robinHood(capacity, 0.95);
+            run("robin hood", robinHood, w);
+            BasicHashTable<DoubleHashing, MixHash> doubleHashing(capacity, 0.95);
+            run("double hashing", doubleHashing, w);
+            BasicHashTable<LinearProbing, MixHash> linear(capacity, 0.95);
+            run("linear", linear, w);
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "../FlightTable.h"
+#include "../HashTable.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Memory per flight and lookup speed for HashTable over a vector<Flight> (pointers into separately
+// allocated records with two std::string members) against FlightTable (8-byte records stored inline,
+// destinations interned). Every lookup reads the destination and the departure time.
+// Usage: Lab7StorageBench [flights]
+namespace
+{
+    const char* const cities[] = {
+        "Moscow", "Saint Petersburg", "Novosibirsk", "Yekaterinburg", "Kazan", "Nizhny Novgorod",
+        "Chelyabinsk", "Samara", "Omsk", "Rostov-on-Don", "Ufa", "Krasnoyarsk", "Voronezh", "Perm",
+        "Volgograd", "Krasnodar", "Saratov", "Tyumen", "Tolyatti", "Izhevsk", "Barnaul", "Ulyanovsk",
+        "Irkutsk", "Khabarovsk", "Yaroslavl", "Vladivostok", "Makhachkala", "Tomsk", "Orenburg",
+        "Kemerovo", "Novokuznetsk", "Ryazan", "Astrakhan", "Naberezhnye Chelny", "Penza", "Kirov",
+        "Lipetsk", "Kaliningrad", "Sochi", "Murmansk", "Arkhangelsk", "Yakutsk", "Magadan",
+        "Petropavlovsk-Kamchatsky", "Yuzhno-Sakhalinsk", "Norilsk", "Syktyvkar", "Salekhard",
+    };
+
+    // Heap bytes behind a std::string beyond the object itself.
+    std::size_t stringHeap(const std::string& s)
+    {
+        return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = bench::argOr(argc, argv, 1, 1'000'000);
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<std::size_t> cityDist(0, std::size(cities) - 1);
+    std::uniform_int_distribution<int> minuteDist(0, 24 * 60 - 1);
+
+    std::vector<Flight> flights(n);
+    for (std::size_t i = 0; i < n; ++i)
+        flights[i] = { cities[cityDist(gen)], static_cast<int>((i + 1) * 101), formatDepartureTime(static_cast<std::uint16_t>(minuteDist(gen))) };
+    std::vector<int> keys;
+    for (const auto& flight : flights) keys.push_back(flight.flightNumber);
+    std::shuffle(keys.begin(), keys.end(), gen);
+
+    HashTable pointers;
+    double pointerInsert = bench::measure([&] {
+        for (auto& flight : flights) pointers.insert(&flight);
+    });
+    std::size_t pointerBytes = pointers.capacity() * (sizeof(Flight*) + 1) + n * sizeof(Flight);
+    for (const auto& flight : flights) pointerBytes += stringHeap(flight.destination) + stringHeap(flight.departureTime);
+
+    FlightTable owning;
+    double owningInsert = bench::measure([&] {
+        for (const auto& flight : flights) owning.insert(flight);
+    });
+
+    std::cout << "flights: " << n << ", destinations: " << owning.destinations().size() << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  HashTable + vector<Flight>  " << static_cast<double>(pointerBytes) / n << " bytes per flight" << std::endl
+              << "  FlightTable                 " << owning.bytesPerRecord() << " bytes per flight" << std::endl;
+
+    bench::report("  HashTable insert", pointerInsert, n);
+    bench::report("  FlightTable insert", owningInsert, n);
+
+    std::size_t sum = 0;
+    bench::report("  HashTable lookup", bench::measure([&] {
+        for (int key : keys) {
+            const Flight* flight = pointers.search(key);
+            sum += flight->destination.size() + flight->departureTime[4];
+        }
+    }), n);
+    bench::report("  FlightTable lookup", bench::measure([&] {
+        for (int key : keys) {
+            std::optional<FlightRecord> record = owning.find(key);
+            sum += owning.destination(*record).size() + record->departureMinutes;
+        }
+    }), n);
+    bench::report("  FlightTable lookup as Flight", bench::measure([&] {
+        for (int key : keys) sum += owning.search(key)->destination.size();
+    }), n);
+    bench::doNotOptimize(sum);
+
+    for (const auto& flight : flights) {
+        std::optional<Flight> copy = owning.search(flight.flightNumber);
+        if (!copy || copy->destination != flight.destination || copy->departureTime != flight.departureTime) {
+            std::cerr << "mismatch for flight " << flight.flightNumber << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -1,85 +1,83 @@
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <string>
+#include "HashTable.h"
+#include "FlightLoader.h"
 
 using namespace std;
 
 const int n = 8;
-const int M = 10;
 
-struct Flight {
-    string destination;
-    int flightNumber;
-    string departureTime;
-};
-
-class HashTable {
-private:
-    vector<Flight*> table;
-    vector<bool> occupied;
-
-    int hash1(int key) {
-        return key % M;
+//  : Lab7 < > [< > [< >]]
+//   -- CSV ", ,:"   ,  saveBinary().
+//            ",,:"  ",,".
+//        ,   --   .
+int runBatch(int argc, char* argv[]) {
+    bool toStdout = argc == 3;
+    ostream& info = toStdout ? cerr : cout;
+    FlightTable table;
+    LoadStats stats;
+    try {
+        stats = loadFlights(argv[1], table);
     }
-
-    int hash2(int key) {
-        return 1 + (key % (M - 2));
+    catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
     }
-
-public:
-    HashTable() : table(M, nullptr), occupied(M, false) {}
-
-    void insert(Flight* flight) {
-        int key = flight->flightNumber;
-        int index = hash1(key);
-
-        if (!occupied[index]) {
-            table[index] = flight;
-            occupied[index] = true;
-            return;
-        }
-
-        int step = hash2(key);
-        for (int i = 0; i < M; i++) {
-            index = index - step;
-            if (index < 0) index += M;
-            if (!occupied[index]) {
-                table[index] = flight;
-                occupied[index] = true;
-                return;
-            }
-        }
-        cout << "- ,  : " << key << endl;
+    double loadSeconds = stats.parseSeconds + stats.insertSeconds;
+    info << " : " << stats.flights << " (: " << table.size() << ")  " << stats.bytes << "   "
+         << loadSeconds * 1e3 << " " << endl;
+    info << ": " << stats.bytes / 1e6 / stats.parseSeconds << " /, : "
+         << stats.flights / stats.insertSeconds << " /" << endl;
+
+    if (argc < 3) return 0;
+    vector<int> queries;
+    try {
+        queries = readFlightNumbers(argv[2]);
     }
-
-    Flight* search(int key) {
-        int index = hash1(key);
-        int step = hash2(key);
-
-        for (int i = 0; i < M; i++) {
-            if (!occupied[index]) return nullptr;
-            if (table[index] && table[index]->flightNumber == key) return table[index];
-            index = index - step;
-            if (index < 0) index += M;
-        }
-        return nullptr;
+    catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    ofstream file;
+    if (!toStdout) file.open(argv[3], ios::binary);
+    ostream& out = toStdout ? cout : file;
+    if (!toStdout && !file) {
+        cerr << "   " << argv[3] << endl;
+        return 1;
     }
 
-    void display() {
-        cout << "-:" << endl;
-        for (int i = 0; i < M; i++) {
-            if (occupied[i] && table[i]) {
-                cout << i << ": " << table[i]->flightNumber << " -> " << table[i]->destination << " (" << table[i]->departureTime << ")" << endl;
-            }
-            else {
-                cout << i << ": " << endl;
-            }
+    string results;
+    results.reserve(queries.size() * 24);
+    size_t found = 0;
+    auto start = chrono::steady_clock::now();
+    for (int key : queries) {
+        results += to_string(key);
+        results += ',';
+        if (optional<FlightRecord> record = table.find(key)) {
+            results += table.destination(*record);
+            results += ',';
+            results += formatDepartureTime(record->departureMinutes);
+            found++;
         }
+        else {
+            results += ',';
+        }
+        results += '\n';
     }
-};
+    double querySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    out.write(results.data(), static_cast<streamsize>(results.size()));
+
+    info << ": " << queries.size() << ", : " << found << ", "
+         << queries.size() / querySeconds << " /" << endl;
+    return 0;
+}
 
-int main() {
+int main(int argc, char* argv[]) {
     setlocale(LC_ALL, "ru");
+    if (argc > 1) return runBatch(argc, argv);
 
     Flight flights[n] = {
         {"", 101, "08:00"},